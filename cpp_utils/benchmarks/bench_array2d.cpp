@@ -0,0 +1,173 @@
+#include "bench_common.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cpp_utils/array2d.hpp>
+#include <cpp_utils/array2d_builder.hpp>
+#include <cpp_utils/find_next.hpp>
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <random>
+#include <vector>
+
+namespace {
+
+  using cpp_utils::Array2DBuilder;
+  using cpp_utils::Array2DCoords;
+  using cpp_utils::Direction;
+
+  // Directions which can be used to flatten the whole array
+  constexpr std::array<Direction, 4> kFlattenDirections = {Direction::East, Direction::South,
+                                                           Direction::West, Direction::North};
+
+  void BM_Array2DIteration(benchmark::State& state) {
+    auto const side = static_cast<size_t>(state.range(0));
+    auto const direction = kFlattenDirections[static_cast<size_t>(state.range(1))];
+    auto const array = Array2DBuilder<char>::create_from_string(
+        cpp_utils_bench::make_grid_input(side), "\n", "");
+    for (auto _ : state) {
+      size_t count = 0;
+      for (auto it = array.begin(direction); it != array.end(direction); ++it) {
+        count += *it == '#';
+      }
+      benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(side * side));
+  }
+  BENCHMARK(BM_Array2DIteration)->ArgsProduct({{64, 512}, {0, 1, 2, 3}});
+
+  void BM_SparseArray2DIteration(benchmark::State& state) {
+    auto const side = static_cast<size_t>(state.range(0));
+    auto const direction = kFlattenDirections[static_cast<size_t>(state.range(1))];
+    auto const array = Array2DBuilder<char>::create_sparse_from_string(
+        cpp_utils_bench::make_grid_input(side), '.', "\n", "");
+    for (auto _ : state) {
+      size_t count = 0;
+      for (auto it = array.begin(direction); it != array.end(direction); ++it) {
+        count += *it == '#';
+      }
+      benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(side * side));
+  }
+  BENCHMARK(BM_SparseArray2DIteration)->ArgsProduct({{64, 256}, {0, 1, 2, 3}});
+
+  // Long straight-line scans for the only '#' in the last cell of the first row or column,
+  // through find_next (range(1) == 0) or the iterators (range(1) == 1)
+  void BM_Array2DFindNext(benchmark::State& state) {
+    auto const side = static_cast<size_t>(state.range(0));
+    auto const use_iterators = state.range(1) == 1;
+    auto const direction = state.range(2) == 0 ? Direction::East : Direction::South;
+    cpp_utils::Array2D<char> array({side, side}, '.');
+    auto const last = side - 1;
+    array(direction == Direction::East ? 0 : last, direction == Direction::East ? last : 0) = '#';
+    auto const start = Array2DCoords{0, 0};
+    for (auto _ : state) {
+      std::optional<Array2DCoords> found;
+      if (use_iterators) {
+        auto const range = array.range_from(start, direction);
+        for (auto it = range.begin(); it != range.end(); ++it) {
+          if (*it == '#') {
+            found = it.coords();
+            break;
+          }
+        }
+      } else {
+        found = cpp_utils::find_next(array, start, direction, '#');
+      }
+      benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(side));
+  }
+  BENCHMARK(BM_Array2DFindNext)->ArgsProduct({{1024, 8192}, {0, 1}, {0, 1}});
+
+  void BM_Array2DRandomAccess(benchmark::State& state) {
+    auto const side = static_cast<size_t>(state.range(0));
+    auto const array = Array2DBuilder<char>::create_from_string(
+        cpp_utils_bench::make_grid_input(side), "\n", "");
+    std::mt19937 generator(7);
+    std::uniform_int_distribution<size_t> index(0, side - 1);
+    std::vector<Array2DCoords> coords(4096);
+    for (auto& c : coords) {
+      c = Array2DCoords{static_cast<int64_t>(index(generator)),
+                        static_cast<int64_t>(index(generator))};
+    }
+    for (auto _ : state) {
+      size_t count = 0;
+      for (auto const& c : coords) {
+        count += array(c) == '#';
+      }
+      benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(coords.size()));
+  }
+  BENCHMARK(BM_Array2DRandomAccess)->Arg(64)->Arg(1024);
+
+  void BM_Array2DNumNeighbors(benchmark::State& state) {
+    auto const side = static_cast<size_t>(state.range(0));
+    bool const diagonal = state.range(1) != 0;
+    auto const array = Array2DBuilder<char>::create_from_string(
+        cpp_utils_bench::make_grid_input(side), "\n", "");
+    for (auto _ : state) {
+      size_t count = 0;
+      for (auto it = array.begin(); it != array.end(); ++it) {
+        count += it.num_neighbors('#', diagonal);
+      }
+      benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(side * side));
+  }
+  BENCHMARK(BM_Array2DNumNeighbors)->ArgsProduct({{128}, {0, 1}});
+
+  void BM_SparseArray2DFind(benchmark::State& state) {
+    auto const side = static_cast<size_t>(state.range(0));
+    auto const direction = kFlattenDirections[static_cast<size_t>(state.range(1))];
+    auto const array = Array2DBuilder<char>::create_sparse_from_string(
+        cpp_utils_bench::make_grid_input(side, 0.02), '.', "\n", "");
+    for (auto _ : state) {
+      size_t found = 0;
+      for (size_t i = 0; i < side; ++i) {
+        auto const start = Array2DCoords{static_cast<int64_t>(i), static_cast<int64_t>(i)};
+        found += array.find_coords_of_non_empty_element_in_direction(start, direction).has_value();
+      }
+      benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(side));
+  }
+  BENCHMARK(BM_SparseArray2DFind)->ArgsProduct({{256, 1024}, {0, 1, 2, 3}});
+
+  void BM_Array2DBuilderCharGrid(benchmark::State& state) {
+    auto const side = static_cast<size_t>(state.range(0));
+    auto const input = cpp_utils_bench::make_grid_input(side);
+    for (auto _ : state) {
+      auto const array = Array2DBuilder<char>::create_from_string(input, "\n", "");
+      benchmark::DoNotOptimize(array(0, 0));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(input.size()));
+  }
+  BENCHMARK(BM_Array2DBuilderCharGrid)->RangeMultiplier(4)->Range(64, 4096);
+
+  void BM_Array2DBuilderNumbers(benchmark::State& state) {
+    auto const side = static_cast<size_t>(state.range(0));
+    auto const input = cpp_utils_bench::make_number_grid_input(side);
+    for (auto _ : state) {
+      auto const array = Array2DBuilder<int>::create_from_string(input);
+      benchmark::DoNotOptimize(array(0, 0));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(input.size()));
+  }
+  BENCHMARK(BM_Array2DBuilderNumbers)->RangeMultiplier(4)->Range(64, 1024);
+
+  void BM_Array2DBuilderSparse(benchmark::State& state) {
+    auto const side = static_cast<size_t>(state.range(0));
+    auto const input = cpp_utils_bench::make_grid_input(side);
+    for (auto _ : state) {
+      auto const array = Array2DBuilder<char>::create_sparse_from_string(input, '.', "\n", "");
+      benchmark::DoNotOptimize(array.size());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(input.size()));
+  }
+  BENCHMARK(BM_Array2DBuilderSparse)->RangeMultiplier(4)->Range(64, 1024);
+
+}  // namespace
@@ -0,0 +1,43 @@
+// Deterministic inputs shared by the benchmarks
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+
+namespace cpp_utils_bench {
+
+  // Square grid of '.' with about one '#' in obstacle_ratio cells, rows separated by '\n'. The
+  // first row is always open, so searches from the upper left corner reach most of the grid.
+  inline std::string make_grid_input(size_t side, double obstacle_ratio = 0.2) {
+    std::mt19937 generator(42);
+    std::bernoulli_distribution obstacle(obstacle_ratio);
+    std::string input;
+    input.reserve(side * (side + 1));
+    for (size_t row = 0; row < side; ++row) {
+      for (size_t col = 0; col < side; ++col) {
+        input += row != 0 && obstacle(generator) ? '#' : '.';
+      }
+      input += '\n';
+    }
+    return input;
+  }
+
+  // Grid of single digits separated by spaces, e.g. "3 1 4\n1 5 9\n"
+  inline std::string make_number_grid_input(size_t side) {
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> digit(0, 9);
+    std::string input;
+    input.reserve(2 * side * side);
+    for (size_t row = 0; row < side; ++row) {
+      for (size_t col = 0; col < side; ++col) {
+        input += static_cast<char>('0' + digit(generator));
+        input += col + 1 == side ? '\n' : ' ';
+      }
+    }
+    return input;
+  }
+
+}  // namespace cpp_utils_bench
@@ -0,0 +1,39 @@
+#include "bench_common.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cpp_utils/input.hpp>
+#include <cpp_utils/integers.hpp>
+
+#include <cstddef>
+#include <string>
+
+namespace {
+
+  void BM_SplitStringLines(benchmark::State& state) {
+    auto const input = cpp_utils_bench::make_number_grid_input(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(cpp_utils::splitString(input, '\n'));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(input.size()));
+  }
+  BENCHMARK(BM_SplitStringLines)->RangeMultiplier(4)->Range(64, 1024);
+
+  void BM_SplitStringMultiByteDelimiter(benchmark::State& state) {
+    auto const input = cpp_utils_bench::make_number_grid_input(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(cpp_utils::splitString(input, " \n"));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(input.size()));
+  }
+  BENCHMARK(BM_SplitStringMultiByteDelimiter)->RangeMultiplier(4)->Range(64, 1024);
+
+  void BM_ExtractIntegers(benchmark::State& state) {
+    auto const input = cpp_utils_bench::make_number_grid_input(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(cpp_utils::extract_integers(input));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(input.size()));
+  }
+  BENCHMARK(BM_ExtractIntegers)->RangeMultiplier(4)->Range(64, 1024);
+
+}  // namespace
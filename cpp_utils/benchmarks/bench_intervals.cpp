@@ -0,0 +1,68 @@
+#include <benchmark/benchmark.h>
+#include <cpp_utils/intervals.hpp>
+
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+
+  std::vector<std::pair<int64_t, int64_t>> random_intervals(size_t count) {
+    std::mt19937_64 generator(42);
+    std::uniform_int_distribution<int64_t> start(0, 1'000'000'000);
+    std::uniform_int_distribution<int64_t> length(0, 10'000);
+    std::vector<std::pair<int64_t, int64_t>> intervals(count);
+    for (auto& [first, last] : intervals) {
+      first = start(generator);
+      last = first + length(generator);
+    }
+    return intervals;
+  }
+
+  void BM_IntervalsInsert(benchmark::State& state) {
+    auto const intervals = random_intervals(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+      cpp_utils::Intervals<int64_t> set;
+      for (auto const& interval : intervals) {
+        set.insert_interval(interval);
+      }
+      benchmark::DoNotOptimize(set.total_area());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+  BENCHMARK(BM_IntervalsInsert)->RangeMultiplier(8)->Range(64, 4096);
+
+  void BM_IntervalsInsertDeferred(benchmark::State& state) {
+    auto const intervals = random_intervals(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+      cpp_utils::Intervals<int64_t> set;
+      for (auto const& [first, last] : intervals) {
+        set.insert_interval_deferred(first, last);
+      }
+      benchmark::DoNotOptimize(set.total_area());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+  BENCHMARK(BM_IntervalsInsertDeferred)->RangeMultiplier(8)->Range(64, 32768);
+
+  void BM_IntervalsContains(benchmark::State& state) {
+    cpp_utils::Intervals<int64_t> const set(random_intervals(static_cast<size_t>(state.range(0))));
+    std::mt19937_64 generator(7);
+    std::uniform_int_distribution<int64_t> value(0, 1'000'000'000);
+    std::vector<int64_t> values(4096);
+    for (auto& v : values) {
+      v = value(generator);
+    }
+    for (auto _ : state) {
+      size_t count = 0;
+      for (auto const v : values) {
+        count += set.contains(v);
+      }
+      benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(values.size()));
+  }
+  BENCHMARK(BM_IntervalsContains)->RangeMultiplier(8)->Range(64, 32768);
+
+}  // namespace
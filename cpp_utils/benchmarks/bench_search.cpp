@@ -0,0 +1,71 @@
+#include "bench_common.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cpp_utils/array2d.hpp>
+#include <cpp_utils/array2d_builder.hpp>
+#include <cpp_utils/grid_graph.hpp>
+#include <cpp_utils/search.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace {
+
+  using cpp_utils::Array2D;
+  using cpp_utils::Array2DCoords;
+
+  // Open direct neighbours of coords which have not been visited yet. Marks them visited, so
+  // every cell is expanded once.
+  auto grid_successors(Array2D<char> const& grid, Array2D<char>& visited) {
+    return [&grid, &visited](Array2DCoords coords) {
+      std::vector<Array2DCoords> successors;
+      for (auto const& next : cpp_utils::get_direct_neighbour_coords(coords)) {
+        if (grid.is_valid_index(next) && grid(next) == '.' && visited(next) == 0) {
+          visited(next) = 1;
+          successors.push_back(next);
+        }
+      }
+      return successors;
+    };
+  }
+
+  template <bool BreadthFirst>
+  void BM_GridSearch(benchmark::State& state) {
+    auto const side = static_cast<size_t>(state.range(0));
+    auto const grid = cpp_utils::Array2DBuilder<char>::create_from_string(
+        cpp_utils_bench::make_grid_input(side), "\n", "");
+    auto const is_dead_end = [](Array2DCoords) { return false; };
+    for (auto _ : state) {
+      Array2D<char> visited(grid.dimensions(), 0);
+      visited(0, 0) = 1;
+      auto const successors = grid_successors(grid, visited);
+      if constexpr (BreadthFirst) {
+        benchmark::DoNotOptimize(
+            cpp_utils::breadthFirstSearch<Array2DCoords>(Array2DCoords{0, 0}, successors,
+                                                         is_dead_end));
+      } else {
+        benchmark::DoNotOptimize(
+            cpp_utils::depthFirstSearch<Array2DCoords>(Array2DCoords{0, 0}, successors,
+                                                       is_dead_end));
+      }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(side * side));
+  }
+  BENCHMARK(BM_GridSearch<true>)->Name("BM_GridBreadthFirstSearch")->Arg(32)->Arg(128);
+  BENCHMARK(BM_GridSearch<false>)->Name("BM_GridDepthFirstSearch")->Arg(32)->Arg(128);
+
+  void BM_GridGraphShortestDistances(benchmark::State& state) {
+    auto const side = static_cast<size_t>(state.range(0));
+    auto const grid = cpp_utils::Array2DBuilder<char>::create_from_string(
+        cpp_utils_bench::make_grid_input(side, 0.3), "\n", "");
+    auto const graph = cpp_utils::contract_grid(
+        grid, [](char c) { return c == '.'; }, {Array2DCoords{0, 0}});
+    auto const source = graph.node_index(Array2DCoords{0, 0}).value();
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(cpp_utils::shortest_distances(graph, source));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(graph.num_nodes()));
+  }
+  BENCHMARK(BM_GridGraphShortestDistances)->Arg(128)->Arg(512);
+
+}  // namespace
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cpp_utils/array2d.hpp>
+#include <cpp_utils/instrumentation.hpp>
 
 #include <charconv>
 #include <span>
@@ -29,32 +30,32 @@ namespace cpp_utils {
   // Iterators for specific rows
   template <typename T>
   Array2DBase<T>::Iterator Array2DBase<T>::begin_row(size_t rowIdx) {
-    if (rowIdx >= num_rows_) {
-      throw std::out_of_range("Row index out of range");
+    if constexpr (DefaultArray2DAccess::checked) {
+      check_row_index(rowIdx);
     }
     return Iterator(*this, Array2DCoords{static_cast<Array2DDim>(rowIdx), 0}, Direction::East,
                     false);
   }
   template <typename T>
   Array2DBase<T>::ConstIterator Array2DBase<T>::begin_row(size_t rowIdx) const {
-    if (rowIdx >= num_rows_) {
-      throw std::out_of_range("Row index out of range");
+    if constexpr (DefaultArray2DAccess::checked) {
+      check_row_index(rowIdx);
     }
     return ConstIterator(*this, Array2DCoords{static_cast<Array2DDim>(rowIdx), 0}, Direction::East,
                          false);
   }
   template <typename T>
   Array2DBase<T>::Iterator Array2DBase<T>::end_row(size_t rowIdx) {
-    if (rowIdx >= num_rows_) {
-      throw std::out_of_range("Row index out of range");
+    if constexpr (DefaultArray2DAccess::checked) {
+      check_row_index(rowIdx);
     }
     return Iterator(*this, end_coords(Array2DCoords{static_cast<Array2DDim>(rowIdx), 0}),
                     Direction::East, false);
   }
   template <typename T>
   Array2DBase<T>::ConstIterator Array2DBase<T>::end_row(size_t rowIdx) const {
-    if (rowIdx >= num_rows_) {
-      throw std::out_of_range("Row index out of range");
+    if constexpr (DefaultArray2DAccess::checked) {
+      check_row_index(rowIdx);
     }
     return ConstIterator(*this, end_coords(Array2DCoords{static_cast<Array2DDim>(rowIdx), 0}),
                          Direction::East, false);
@@ -207,9 +208,11 @@ namespace cpp_utils {
     return result;
   }
 
-  template <typename T>
-  SparseArray2D<T>::SparseArray2D(std::vector<std::vector<T>> data, T empty_element)
-      : base({data.size(), data.at(0).size()}), empty_element_(empty_element) {
+  template <typename T, class Allocator>
+  SparseArray2D<T, Allocator>::SparseArray2D(std::vector<std::vector<T>> data,
+                                             T empty_element,
+                                             Allocator const& allocator)
+      : base({data.size(), data.at(0).size()}), data_(allocator), empty_element_(empty_element) {
     for (auto const [row, row_data] : std::views::enumerate(data)) {
       for (auto const [col, value] : std::views::enumerate(row_data)) {
         if (value != empty_element) {
@@ -219,13 +222,14 @@ namespace cpp_utils {
     }
   }
 
-  template <typename T>
-  SparseArray2D<T>::SparseArray2D(int num_rows,
-                                  int num_columns,
-                                  std::span<const T> const& values,
-                                  T empty_element,
-                                  Direction direction)
-      : base({num_rows, num_columns}), empty_element_(empty_element) {
+  template <typename T, class Allocator>
+  SparseArray2D<T, Allocator>::SparseArray2D(int num_rows,
+                                             int num_columns,
+                                             std::span<const T> const& values,
+                                             T empty_element,
+                                             Direction direction,
+                                             Allocator const& allocator)
+      : base({num_rows, num_columns}), data_(allocator), empty_element_(empty_element) {
     assert(values.size() == base::num_rows() * base::num_columns());
 
     std::ranges::transform(values, base::begin(direction), [](auto const& value) { return value; });
@@ -233,12 +237,13 @@ namespace cpp_utils {
     cleanup();
   }
 
-  template <typename T>
-  SparseArray2D<T>::SparseArray2D(std::tuple<size_t, size_t> dimensions,
-                                  std::span<const T> const& values,
-                                  T empty_element,
-                                  Direction direction)
-      : base(dimensions), empty_element_(empty_element) {
+  template <typename T, class Allocator>
+  SparseArray2D<T, Allocator>::SparseArray2D(std::tuple<size_t, size_t> dimensions,
+                                             std::span<const T> const& values,
+                                             T empty_element,
+                                             Direction direction,
+                                             Allocator const& allocator)
+      : base(dimensions), data_(allocator), empty_element_(empty_element) {
     assert(values.size() == base::num_rows() * base::num_columns());
 
     std::ranges::transform(values, base::begin(direction), [](auto const& value) { return value; });
@@ -246,8 +251,9 @@ namespace cpp_utils {
     cleanup();
   }
 
-  template <typename T>
-  typename Array2DBase<T>::reference SparseArray2D<T>::operator()(size_t row, size_t col) {
+  template <typename T, class Allocator>
+  typename Array2DBase<T>::reference SparseArray2D<T, Allocator>::operator()(size_t row,
+                                                                             size_t col) {
     cleanup();
     auto coords = Array2DCoords{static_cast<Array2DDim>(row), Array2DDim(col)};
     auto [_, inserted] = data_.emplace(coords, empty_element_);
@@ -257,9 +263,10 @@ namespace cpp_utils {
     return data_[coords];
   }
 
-  template <typename T>
-  typename Array2DBase<T>::const_reference SparseArray2D<T>::operator()(size_t row,
-                                                                        size_t col) const {
+  template <typename T, class Allocator>
+  typename Array2DBase<T>::const_reference SparseArray2D<T, Allocator>::operator()(
+      size_t row,
+      size_t col) const {
     auto coords = Array2DCoords{static_cast<Array2DDim>(row), Array2DDim(col)};
     if (!data_.contains(coords)) {
       return empty_element_;
@@ -267,17 +274,21 @@ namespace cpp_utils {
     return data_.at(coords);
   }
 
-  template <typename T>
-  void SparseArray2D<T>::cleanup() {
+  template <typename T, class Allocator>
+  void SparseArray2D<T, Allocator>::cleanup() {
+    // Runs on every non-const access, so only counted instead of timed
+    CPP_UTILS_COUNT("sparse_array2d.cleanup_calls", 1);
     if (cleanup_coords_.has_value() && data_.contains(*cleanup_coords_) &&
         data_.at(*cleanup_coords_) == empty_element_) {
+      CPP_UTILS_COUNT("sparse_array2d.cleanup_erasures", 1);
       data_.erase(*cleanup_coords_);
     }
     cleanup_coords_.reset();
   }
 
-  template <typename T>
-  std::optional<Array2DCoords> SparseArray2D<T>::find_coords_of_non_empty_element_in_direction(
+  template <typename T, class Allocator>
+  std::optional<Array2DCoords>
+  SparseArray2D<T, Allocator>::find_coords_of_non_empty_element_in_direction(
       Array2DCoords const& coords,
       Direction direction) const {
     switch (direction) {
@@ -290,14 +301,15 @@ namespace cpp_utils {
       case Direction::West:
         return find_coords_of_non_empty_element_west(coords);
       default:
-        throw typename base::NotImplementedError(
+        throw NotImplementedError(
             "find non-empty element in diagonal directions not yet implemented");
         return std::nullopt;
     }
   }
 
-  template <typename T>
-  std::optional<Array2DCoords> SparseArray2D<T>::find_coords_of_non_empty_element_east(
+  template <typename T, class Allocator>
+  std::optional<Array2DCoords>
+  SparseArray2D<T, Allocator>::find_coords_of_non_empty_element_east(
       Array2DCoords const& coords) const {
     // we can use that the map is ordered row() by the row() coordinate and then by the col()
     auto it = data_.upper_bound(coords);
@@ -311,8 +323,9 @@ namespace cpp_utils {
     return std::nullopt;
   }
 
-  template <typename T>
-  std::optional<Array2DCoords> SparseArray2D<T>::find_coords_of_non_empty_element_west(
+  template <typename T, class Allocator>
+  std::optional<Array2DCoords>
+  SparseArray2D<T, Allocator>::find_coords_of_non_empty_element_west(
       Array2DCoords const& coords) const {
     // we can use that the map is ordered row() by the row() coordinate and then by the col()
     auto it = data_.lower_bound(coords);
@@ -327,8 +340,9 @@ namespace cpp_utils {
     return std::nullopt;
   }
 
-  template <typename T>
-  std::optional<Array2DCoords> SparseArray2D<T>::find_coords_of_non_empty_element_south(
+  template <typename T, class Allocator>
+  std::optional<Array2DCoords>
+  SparseArray2D<T, Allocator>::find_coords_of_non_empty_element_south(
       Array2DCoords const& coords) const {
     auto row = coords.row() + 1;
     auto column = coords.col();
@@ -342,8 +356,9 @@ namespace cpp_utils {
     return std::nullopt;
   }
 
-  template <typename T>
-  std::optional<Array2DCoords> SparseArray2D<T>::find_coords_of_non_empty_element_north(
+  template <typename T, class Allocator>
+  std::optional<Array2DCoords>
+  SparseArray2D<T, Allocator>::find_coords_of_non_empty_element_north(
       Array2DCoords const& coords) const {
     auto row = coords.row() - 1;
     auto column = coords.col();
@@ -13,4 +13,159 @@ namespace cpp_utils {
     return target_value;
   };
 
-}  // namespace cpp_utils
\ No newline at end of file
+  namespace _array2d_builder_detail {
+
+    // Converts grid rows character by character. Each distinct character is passed to the
+    // converter only once, later occurrences are looked up in a table.
+    template <typename T>
+    class CharTable {
+     public:
+      CharTable(std::function<T(std::string_view)> const& converter, bool copy_bytes)
+          : converter_(converter), copy_bytes_(copy_bytes) {}
+
+      void convert(std::string_view line, std::vector<T>& row) {
+        if constexpr (std::is_same_v<T, char>) {
+          if (copy_bytes_) {
+            row.assign(line.begin(), line.end());
+            return;
+          }
+        }
+        row.resize(line.size());
+        for (size_t col = 0; col < line.size(); ++col) {
+          auto const c = static_cast<unsigned char>(line[col]);
+          if (!converted_[c]) {
+            table_[c] = converter_(line.substr(col, 1));
+            converted_[c] = true;
+          }
+          row[col] = table_[c];
+        }
+      }
+
+     private:
+      std::function<T(std::string_view)> const& converter_;
+      bool copy_bytes_;
+      std::array<T, 256> table_{};
+      std::array<bool, 256> converted_{};
+    };
+
+    // Appends the coordinates of the marker characters in line, which is row row_index
+    inline void find_markers(std::string_view line,
+                             Array2DDim row_index,
+                             std::map<char, std::vector<Array2DCoords>>& markers) {
+      for (auto& [marker, coords] : markers) {
+        auto const* hit = line.data();
+        auto const* const end = line.data() + line.size();
+        while ((hit = static_cast<char const*>(
+                    std::memchr(hit, marker, static_cast<size_t>(end - hit)))) != nullptr) {
+          coords.push_back({row_index, static_cast<Array2DDim>(hit - line.data())});
+          ++hit;
+        }
+      }
+    }
+
+    inline std::map<char, std::vector<Array2DCoords>> empty_markers(std::string_view markers) {
+      std::map<char, std::vector<Array2DCoords>> found;
+      for (auto const marker : markers) {
+        found[marker];
+      }
+      return found;
+    }
+
+  }  // namespace _array2d_builder_detail
+
+  template <typename T>
+  bool Array2DBuilder<T>::is_default_converter(
+      std::function<T(std::string_view)> const& converter) {
+    auto const* const function = converter.template target<T (*)(std::string_view)>();
+    return function != nullptr && *function == &default_converter;
+  }
+
+  template <typename T>
+  CharGrid<T> Array2DBuilder<T>::create_from_char_grid(
+      std::string_view input,
+      std::string_view markers,
+      std::function<T(std::string_view)> converter) {
+    CPP_UTILS_SCOPED_TIMER("array2d_builder.create_from_char_grid");
+    _array2d_builder_detail::CharTable<T> table(converter, is_default_converter(converter));
+    std::vector<std::vector<T>> rows;
+    auto found = _array2d_builder_detail::empty_markers(markers);
+    char const* position = input.data();
+    char const* const end = input.data() + input.size();
+    size_t width = 0;
+    while (position != end) {
+      if (*position == '\n') {
+        ++position;
+        continue;
+      }
+      auto const remaining = static_cast<size_t>(end - position);
+      if (rows.empty()) {
+        auto const* const line_end =
+            static_cast<char const*>(std::memchr(position, '\n', remaining));
+        width = static_cast<size_t>((line_end == nullptr ? end : line_end) - position);
+        rows.reserve(input.size() / (width + 1) + 1);
+      } else if (remaining < width || (remaining > width && position[width] != '\n') ||
+                 std::memchr(position, '\n', width) != nullptr) {
+        throw std::invalid_argument(
+            fmt::format("Row {} of the grid does not have width {}", rows.size(), width));
+      }
+      auto const line = std::string_view(position, width);
+      _array2d_builder_detail::find_markers(line, static_cast<Array2DDim>(rows.size()), found);
+      table.convert(line, rows.emplace_back());
+      position += width;
+    }
+    if (rows.empty()) {
+      throw std::invalid_argument("Grid must have at least one non-empty row");
+    }
+    return CharGrid<T>{Array2D<T>(std::move(rows)), std::move(found)};
+  }
+
+  template <typename T>
+  CharGrid<T> Array2DBuilder<T>::create_from_char_grid_parallel(
+      std::string_view input,
+      ThreadPool& pool,
+      std::string_view markers,
+      std::function<T(std::string_view)> converter) {
+    CPP_UTILS_SCOPED_TIMER("array2d_builder.create_from_char_grid_parallel");
+    while (!input.empty() && input.back() == '\n') {
+      input.remove_suffix(1);
+    }
+    auto const width = input.find('\n') == std::string_view::npos ? input.size() : input.find('\n');
+    if (width == 0) {
+      throw std::invalid_argument("Grid must have at least one non-empty row");
+    }
+    // All rows have the same width, so row r starts at r * (width + 1)
+    if ((input.size() + 1) % (width + 1) != 0) {
+      throw std::invalid_argument(
+          fmt::format("Grid rows must all have width {} without empty lines between", width));
+    }
+    auto const num_rows = (input.size() + 1) / (width + 1);
+    std::vector<std::vector<T>> rows(num_rows);
+
+    auto const num_tasks = std::min(num_rows, 4 * pool.num_threads());
+    std::vector<std::map<char, std::vector<Array2DCoords>>> found(
+        num_tasks, _array2d_builder_detail::empty_markers(markers));
+    bool const copy_bytes = is_default_converter(converter);
+    pool.run(num_tasks, [&](size_t task) {
+      _array2d_builder_detail::CharTable<T> table(converter, copy_bytes);
+      for (auto row = task * num_rows / num_tasks; row < (task + 1) * num_rows / num_tasks; ++row) {
+        auto const line = input.substr(row * (width + 1), width);
+        if ((row + 1 < num_rows && input[row * (width + 1) + width] != '\n') ||
+            line.find('\n') != std::string_view::npos) {
+          throw std::invalid_argument(
+              fmt::format("Row {} of the grid does not have width {}", row, width));
+        }
+        _array2d_builder_detail::find_markers(line, static_cast<Array2DDim>(row), found[task]);
+        table.convert(line, rows[row]);
+      }
+    });
+
+    auto merged = _array2d_builder_detail::empty_markers(markers);
+    for (auto& task_markers : found) {
+      for (auto& [marker, coords] : task_markers) {
+        std::ranges::move(coords, std::back_inserter(merged[marker]));
+      }
+    }
+    return CharGrid<T>{Array2D<T>(std::move(rows)), std::move(merged)};
+  }
+
+}  // namespace cpp_utils
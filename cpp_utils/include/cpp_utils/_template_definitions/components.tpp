@@ -0,0 +1,192 @@
+// Implementation of component labeling and flood fill.
+
+#pragma once
+
+#include <cpp_utils/components.hpp>
+
+#include <algorithm>
+#include <utility>
+
+namespace cpp_utils {
+
+  namespace _components_detail {
+
+    // Finds the root of a union-find forest using path halving
+    inline int32_t find_root(std::vector<int32_t>& parent, int32_t label) {
+      while (parent[label] != label) {
+        parent[label] = parent[parent[label]];
+        label = parent[label];
+      }
+      return label;
+    }
+
+    // Unites the sets of a and b, the smaller root becomes the root of both
+    inline int32_t unite(std::vector<int32_t>& parent, int32_t a, int32_t b) {
+      a = find_root(parent, a);
+      b = find_root(parent, b);
+      if (a > b) {
+        std::swap(a, b);
+      }
+      parent[b] = a;
+      return a;
+    }
+
+    template <typename T>
+    void read_row(Array2DBase<T> const& array, size_t row, std::vector<T>& values) {
+      values.clear();
+      for (size_t col = 0; col < array.num_columns(); ++col) {
+        values.push_back(array(row, col));
+      }
+    }
+
+  }  // namespace _components_detail
+
+  template <typename T, class SameRegion>
+  ComponentLabeling label_components(Array2DBase<T> const& array, SameRegion same_region) {
+    // First pass: assign provisional labels in raster order and record which labels touch via
+    // union-find. Only the current and the previous row of values are kept.
+    // Second pass: replace the provisional labels by their compact final label and collect the
+    // per-component information.
+    auto const num_rows = array.num_rows();
+    auto const num_columns = array.num_columns();
+    if (num_rows == 0 || num_columns == 0) {
+      return ComponentLabeling{Array2D<int32_t>({num_rows, num_columns}), {}};
+    }
+
+    std::vector<int32_t> provisional(num_rows * num_columns);
+    std::vector<int32_t> parent;
+    std::vector<T> previous_row;
+    std::vector<T> current_row;
+    for (size_t row = 0; row < num_rows; ++row) {
+      _components_detail::read_row(array, row, current_row);
+      for (size_t col = 0; col < num_columns; ++col) {
+        auto const index = row * num_columns + col;
+        bool const joins_west = col > 0 && same_region(current_row[col - 1], current_row[col]);
+        bool const joins_north = row > 0 && same_region(previous_row[col], current_row[col]);
+        if (joins_west && joins_north) {
+          provisional[index] =
+              _components_detail::unite(parent, provisional[index - 1],
+                                        provisional[index - num_columns]);
+        } else if (joins_west) {
+          provisional[index] = provisional[index - 1];
+        } else if (joins_north) {
+          provisional[index] = provisional[index - num_columns];
+        } else {
+          provisional[index] = static_cast<int32_t>(parent.size());
+          parent.push_back(provisional[index]);
+        }
+      }
+      std::swap(previous_row, current_row);
+    }
+
+    // Roots are numbered in order of first appearance, which is the row-major order
+    std::vector<int32_t> final_label(parent.size(), -1);
+    std::vector<ComponentInfo> components;
+    std::vector<std::vector<int32_t>> labels(num_rows, std::vector<int32_t>(num_columns));
+    for (size_t row = 0; row < num_rows; ++row) {
+      for (size_t col = 0; col < num_columns; ++col) {
+        auto const root =
+            _components_detail::find_root(parent, provisional[row * num_columns + col]);
+        if (final_label[root] < 0) {
+          final_label[root] = static_cast<int32_t>(components.size());
+          auto const coords =
+              Array2DCoords{static_cast<Array2DDim>(row), static_cast<Array2DDim>(col)};
+          components.push_back(ComponentInfo{0, 0, coords, coords});
+        }
+        auto const label = final_label[root];
+        labels[row][col] = label;
+
+        auto& info = components[label];
+        ++info.area;
+        info.upper_left.row() = std::min<Array2DDim>(info.upper_left.row(), row);
+        info.upper_left.col() = std::min<Array2DDim>(info.upper_left.col(), col);
+        info.lower_right.row() = std::max<Array2DDim>(info.lower_right.row(), row);
+        info.lower_right.col() = std::max<Array2DDim>(info.lower_right.col(), col);
+
+        // Count the edges towards north and west here, those towards south and east are counted
+        // once the neighbour is labeled (or here when at the border)
+        if (row == 0 || labels[row - 1][col] != label) {
+          ++info.perimeter;
+          if (row > 0) {
+            ++components[labels[row - 1][col]].perimeter;
+          }
+        }
+        if (col == 0 || labels[row][col - 1] != label) {
+          ++info.perimeter;
+          if (col > 0) {
+            ++components[labels[row][col - 1]].perimeter;
+          }
+        }
+        if (row == num_rows - 1) {
+          ++info.perimeter;
+        }
+        if (col == num_columns - 1) {
+          ++info.perimeter;
+        }
+      }
+    }
+
+    return ComponentLabeling{Array2D<int32_t>(std::move(labels)), std::move(components)};
+  }
+
+  template <typename T, class SameRegion>
+  std::vector<Array2DCoords> flood_fill(Array2DBase<T> const& array,
+                                        Array2DCoords start,
+                                        SameRegion same_region) {
+    // Scanline flood fill: each seed is extended to the maximal horizontal span, then the rows
+    // above and below the span are scanned for new seeds. One seed is pushed per run of matching
+    // cells, visited cells are tracked in a flat array instead of a hash set.
+    if (!array.is_valid_index(start)) {
+      throw std::out_of_range("Flood fill start coordinates out of range");
+    }
+    auto const num_rows = static_cast<Array2DDim>(array.num_rows());
+    auto const num_columns = static_cast<Array2DDim>(array.num_columns());
+    std::vector<uint8_t> visited(array.num_rows() * array.num_columns(), 0);
+    auto is_visited = [&visited, num_columns](Array2DDim row, Array2DDim col) -> uint8_t& {
+      return visited[row * num_columns + col];
+    };
+
+    std::vector<Array2DCoords> region;
+    std::vector<Array2DCoords> seeds = {start};
+    is_visited(start.row(), start.col()) = 1;
+    while (!seeds.empty()) {
+      auto const seed = seeds.back();
+      seeds.pop_back();
+      auto const row = seed.row();
+
+      auto left = seed.col();
+      while (left > 0 && !is_visited(row, left - 1) &&
+             same_region(array(row, left - 1), array(row, left))) {
+        --left;
+        is_visited(row, left) = 1;
+      }
+      auto right = seed.col();
+      while (right < num_columns - 1 && !is_visited(row, right + 1) &&
+             same_region(array(row, right + 1), array(row, right))) {
+        ++right;
+        is_visited(row, right) = 1;
+      }
+      for (auto col = left; col <= right; ++col) {
+        region.push_back(Array2DCoords{row, col});
+      }
+
+      for (auto const neighbour_row : {row - 1, row + 1}) {
+        if (neighbour_row < 0 || neighbour_row >= num_rows) {
+          continue;
+        }
+        bool in_run = false;
+        for (auto col = left; col <= right; ++col) {
+          bool const matches = !is_visited(neighbour_row, col) &&
+                               same_region(array(row, col), array(neighbour_row, col));
+          if (matches && !in_run) {
+            is_visited(neighbour_row, col) = 1;
+            seeds.push_back(Array2DCoords{neighbour_row, col});
+          }
+          in_run = matches;
+        }
+      }
+    }
+    return region;
+  }
+
+}  // namespace cpp_utils
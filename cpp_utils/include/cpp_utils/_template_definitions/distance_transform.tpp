@@ -0,0 +1,212 @@
+// Implementation of the distance transforms.
+
+#pragma once
+
+#include <cpp_utils/distance_transform.hpp>
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace cpp_utils {
+
+  namespace _distance_transform_detail {
+
+    // Adds a step to a distance, unreachable cells stay unreachable
+    inline int32_t step(int32_t distance, int32_t length = 1) {
+      return distance == unreachable_distance ? unreachable_distance : distance + length;
+    }
+
+    inline int64_t max_distance(size_t num_rows, size_t num_columns, DistanceMetric metric) {
+      auto const rows = static_cast<int64_t>(num_rows) - 1;
+      auto const columns = static_cast<int64_t>(num_columns) - 1;
+      switch (metric) {
+        case DistanceMetric::Manhattan:
+          return rows + columns;
+        case DistanceMetric::Chebyshev:
+          return std::max(rows, columns);
+        case DistanceMetric::SquaredEuclidean:
+          return rows * rows + columns * columns;
+      }
+      throw std::invalid_argument("Unknown distance metric");
+    }
+
+    // Forward scan over the north-west half of the neighbourhood followed by a backward scan
+    // over the south-east half. With unit steps to all eight neighbours (diagonal) this gives the
+    // Chebyshev distance, with steps to the direct neighbours only the Manhattan distance.
+    inline void two_pass_scan(std::vector<int32_t>& distances,
+                              size_t num_rows,
+                              size_t num_columns,
+                              bool diagonal) {
+      for (size_t row = 0; row < num_rows; ++row) {
+        int32_t* current = distances.data() + row * num_columns;
+        int32_t const* above = row > 0 ? current - num_columns : nullptr;
+        for (size_t col = 0; col < num_columns; ++col) {
+          auto best = current[col];
+          if (col > 0) {
+            best = std::min(best, step(current[col - 1]));
+          }
+          if (above != nullptr) {
+            best = std::min(best, step(above[col]));
+            if (diagonal && col > 0) {
+              best = std::min(best, step(above[col - 1]));
+            }
+            if (diagonal && col + 1 < num_columns) {
+              best = std::min(best, step(above[col + 1]));
+            }
+          }
+          current[col] = best;
+        }
+      }
+      for (size_t row = num_rows; row-- > 0;) {
+        int32_t* current = distances.data() + row * num_columns;
+        int32_t const* below = row + 1 < num_rows ? current + num_columns : nullptr;
+        for (size_t col = num_columns; col-- > 0;) {
+          auto best = current[col];
+          if (col + 1 < num_columns) {
+            best = std::min(best, step(current[col + 1]));
+          }
+          if (below != nullptr) {
+            best = std::min(best, step(below[col]));
+            if (diagonal && col + 1 < num_columns) {
+              best = std::min(best, step(below[col + 1]));
+            }
+            if (diagonal && col > 0) {
+              best = std::min(best, step(below[col - 1]));
+            }
+          }
+          current[col] = best;
+        }
+      }
+    }
+
+    // Scratch buffers of lower_envelope, reused for all rows
+    struct Envelope {
+      // Roots and values of the parabolas of the lower envelope
+      std::vector<int64_t> vertices;
+      std::vector<int64_t> values;
+      // Parabola k is the lowest one between boundaries[k] and boundaries[k + 1]
+      std::vector<double> boundaries;
+
+      explicit Envelope(size_t size) : vertices(size), values(size), boundaries(size + 1) {}
+    };
+
+    // One-dimensional squared Euclidean transform of f in place: f[q] becomes the minimum of
+    // (q - p)^2 + f[p] over all p, i.e. the lower envelope of the parabolas rooted at the finite
+    // values of f
+    inline void lower_envelope(std::span<int32_t> f, Envelope& envelope) {
+      auto& [vertices, values, boundaries] = envelope;
+      auto const size = static_cast<int64_t>(f.size());
+      size_t num_vertices = 0;
+      for (int64_t q = 0; q < size; ++q) {
+        if (f[q] == unreachable_distance) {
+          continue;
+        }
+        auto const value = static_cast<int64_t>(f[q]);
+        auto boundary = -std::numeric_limits<double>::infinity();
+        // Drop the parabolas which are hidden by the new one, the intersection of the parabolas
+        // rooted at p < q is at ((f[q] + q^2) - (f[p] + p^2)) / (2 (q - p))
+        while (num_vertices > 0) {
+          auto const p = vertices[num_vertices - 1];
+          boundary = static_cast<double>(value + q * q - values[num_vertices - 1] - p * p) /
+                     static_cast<double>(2 * (q - p));
+          if (boundary > boundaries[num_vertices - 1]) {
+            break;
+          }
+          --num_vertices;
+          boundary = -std::numeric_limits<double>::infinity();
+        }
+        vertices[num_vertices] = q;
+        values[num_vertices] = value;
+        boundaries[num_vertices] = boundary;
+        ++num_vertices;
+      }
+      if (num_vertices == 0) {
+        return;
+      }
+      boundaries[num_vertices] = std::numeric_limits<double>::infinity();
+
+      size_t k = 0;
+      for (int64_t q = 0; q < size; ++q) {
+        while (boundaries[k + 1] < static_cast<double>(q)) {
+          ++k;
+        }
+        auto const offset = q - vertices[k];
+        f[q] = static_cast<int32_t>(offset * offset + values[k]);
+      }
+    }
+
+    inline void squared_euclidean(std::vector<int32_t>& distances,
+                                  size_t num_rows,
+                                  size_t num_columns) {
+      // Vertical distance to the nearest source in the same column, computed row by row with a
+      // forward and a backward scan so that the memory is accessed contiguously
+      for (size_t row = 1; row < num_rows; ++row) {
+        int32_t* current = distances.data() + row * num_columns;
+        int32_t const* above = current - num_columns;
+        for (size_t col = 0; col < num_columns; ++col) {
+          current[col] = std::min(current[col], step(above[col]));
+        }
+      }
+      for (size_t row = num_rows - 1; row-- > 0;) {
+        int32_t* current = distances.data() + row * num_columns;
+        int32_t const* below = current + num_columns;
+        for (size_t col = 0; col < num_columns; ++col) {
+          current[col] = std::min(current[col], step(below[col]));
+        }
+      }
+      for (auto& distance : distances) {
+        if (distance != unreachable_distance) {
+          distance *= distance;
+        }
+      }
+
+      // Combine the squared vertical distances along each row
+      Envelope envelope(num_columns);
+      for (size_t row = 0; row < num_rows; ++row) {
+        lower_envelope(std::span(distances.data() + row * num_columns, num_columns), envelope);
+      }
+    }
+
+  }  // namespace _distance_transform_detail
+
+  template <typename T, class IsSource>
+  Array2D<int32_t> distance_transform(Array2DBase<T> const& array,
+                                      IsSource is_source,
+                                      DistanceMetric metric) {
+    auto const num_rows = array.num_rows();
+    auto const num_columns = array.num_columns();
+    if (num_rows == 0 || num_columns == 0) {
+      return Array2D<int32_t>({num_rows, num_columns});
+    }
+    if (_distance_transform_detail::max_distance(num_rows, num_columns, metric) >=
+        unreachable_distance) {
+      throw std::out_of_range(fmt::format(
+          "Distances of an array of size {}x{} do not fit into int32_t", num_rows, num_columns));
+    }
+
+    std::vector<int32_t> distances(num_rows * num_columns);
+    for (size_t row = 0; row < num_rows; ++row) {
+      for (size_t col = 0; col < num_columns; ++col) {
+        distances[row * num_columns + col] = is_source(array(row, col)) ? 0 : unreachable_distance;
+      }
+    }
+
+    switch (metric) {
+      case DistanceMetric::Manhattan:
+        _distance_transform_detail::two_pass_scan(distances, num_rows, num_columns, false);
+        break;
+      case DistanceMetric::Chebyshev:
+        _distance_transform_detail::two_pass_scan(distances, num_rows, num_columns, true);
+        break;
+      case DistanceMetric::SquaredEuclidean:
+        _distance_transform_detail::squared_euclidean(distances, num_rows, num_columns);
+        break;
+    }
+    return Array2D<int32_t>({num_rows, num_columns}, std::span<int32_t const>(distances));
+  }
+
+}  // namespace cpp_utils
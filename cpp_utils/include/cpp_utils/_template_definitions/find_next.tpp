@@ -0,0 +1,187 @@
+// Implementation of find_next.
+
+#pragma once
+
+#include <cpp_utils/find_next.hpp>
+
+#ifdef __GLIBC__
+#include <string.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+namespace cpp_utils {
+
+  namespace _find_next_detail {
+
+    // Elements which can be compared bytewise with memchr
+    template <typename T>
+    inline constexpr bool is_byte_comparable_v =
+        sizeof(T) == 1 && std::is_trivially_copyable_v<T> && !std::is_same_v<T, bool>;
+
+    inline Array2DCoords make_coords(size_t row, size_t col) {
+      return Array2DCoords{static_cast<Array2DDim>(row), static_cast<Array2DDim>(col)};
+    }
+
+    // Number of rows scanned together, the matches of a block are collected in a bit mask
+    // without branching and only the mask is tested
+    inline constexpr size_t block_rows = 8;
+
+    template <typename T, class Access, class Match>
+    std::optional<Array2DCoords> find_in_row(Array2D<T, Access> const& array,
+                                             size_t row,
+                                             size_t col,
+                                             bool forward,
+                                             Match const& match) {
+      auto const elements = array.row_span(row);
+      if (forward) {
+        auto const rest = elements.subspan(col + 1);
+        auto const it = std::ranges::find_if(rest, match);
+        if (it == rest.end()) {
+          return std::nullopt;
+        }
+        return make_coords(row, col + 1 + (it - rest.begin()));
+      }
+      auto const before = elements.first(col);
+      auto const it = std::ranges::find_if(before.rbegin(), before.rend(), match);
+      if (it == before.rend()) {
+        return std::nullopt;
+      }
+      return make_coords(row, col - 1 - (it - before.rbegin()));
+    }
+
+    template <typename T, class Access, class Match>
+    std::optional<Array2DCoords> find_in_column(Array2D<T, Access> const& array,
+                                                size_t row,
+                                                size_t col,
+                                                bool forward,
+                                                Match const& match) {
+      // The rows are separate allocations, so each block gathers one element of each of its
+      // rows. Rows are numbered in scan order: forward from row + 1, backward from row - 1.
+      auto const num_candidates = forward ? array.num_rows() - row - 1 : row;
+      auto const row_at = [row, forward](size_t offset) {
+        return forward ? row + 1 + offset : row - 1 - offset;
+      };
+      size_t offset = 0;
+      for (; offset + block_rows <= num_candidates; offset += block_rows) {
+        uint32_t mask = 0;
+        for (size_t k = 0; k < block_rows; ++k) {
+          mask |= static_cast<uint32_t>(match(array.row_span(row_at(offset + k))[col])) << k;
+        }
+        if (mask != 0) {
+          return make_coords(row_at(offset + std::countr_zero(mask)), col);
+        }
+      }
+      for (; offset < num_candidates; ++offset) {
+        if (match(array.row_span(row_at(offset))[col])) {
+          return make_coords(row_at(offset), col);
+        }
+      }
+      return std::nullopt;
+    }
+
+    template <typename T, class Access, class Match>
+    std::optional<Array2DCoords> find_dense(Array2D<T, Access> const& array,
+                                            Array2DCoords coords,
+                                            Direction direction,
+                                            Match const& match) {
+      array.check_index(coords.row(), coords.col());
+      auto const row = static_cast<size_t>(coords.row());
+      auto const col = static_cast<size_t>(coords.col());
+      switch (direction) {
+        case Direction::East:
+          return find_in_row(array, row, col, true, match);
+        case Direction::West:
+          return find_in_row(array, row, col, false, match);
+        case Direction::South:
+          return find_in_column(array, row, col, true, match);
+        case Direction::North:
+          return find_in_column(array, row, col, false, match);
+        default:
+          return find_next(static_cast<Array2DBase<T> const&>(array), coords, direction, match);
+      }
+    }
+
+  }  // namespace _find_next_detail
+
+  template <typename T, class Access, class Predicate>
+    requires std::predicate<Predicate const&, T const&>
+  std::optional<Array2DCoords> find_next(Array2D<T, Access> const& array,
+                                         Array2DCoords coords,
+                                         Direction direction,
+                                         Predicate const& predicate) {
+    return _find_next_detail::find_dense(array, coords, direction, predicate);
+  }
+
+  template <typename T, class Access>
+  std::optional<Array2DCoords> find_next(Array2D<T, Access> const& array,
+                                         Array2DCoords coords,
+                                         Direction direction,
+                                         std::type_identity_t<T> const& value) {
+    if constexpr (_find_next_detail::is_byte_comparable_v<T>) {
+      // memchr and memrchr compare whole words or vectors at a time. memrchr is a GNU extension,
+      // elsewhere West uses the reverse row scan of find_dense.
+#ifdef __GLIBC__
+      bool const bytewise = direction == Direction::East || direction == Direction::West;
+#else
+      bool const bytewise = direction == Direction::East;
+#endif
+      if (bytewise) {
+        array.check_index(coords.row(), coords.col());
+        auto const elements = array.row_span(coords.row());
+        auto const col = static_cast<size_t>(coords.col());
+        unsigned char byte;
+        std::memcpy(&byte, &value, 1);
+#ifdef __GLIBC__
+        void const* found =
+            direction == Direction::East
+                ? std::memchr(elements.data() + col + 1, byte, elements.size() - col - 1)
+                : ::memrchr(elements.data(), byte, col);
+#else
+        void const* found = std::memchr(elements.data() + col + 1, byte, elements.size() - col - 1);
+#endif
+        if (found == nullptr) {
+          return std::nullopt;
+        }
+        auto const found_col = static_cast<T const*>(found) - elements.data();
+        return Array2DCoords{coords.row(), static_cast<Array2DDim>(found_col)};
+      }
+    }
+    return _find_next_detail::find_dense(array, coords, direction,
+                                         [&value](T const& element) { return element == value; });
+  }
+
+  template <typename T, class Predicate>
+    requires std::predicate<Predicate const&, T const&>
+  std::optional<Array2DCoords> find_next(Array2DBase<T> const& array,
+                                         Array2DCoords coords,
+                                         Direction direction,
+                                         Predicate const& predicate) {
+    array.check_index(coords.row(), coords.col());
+    auto const start = array.step_coords_towards_direction(coords, direction);
+    if (!array.is_valid_index(start)) {
+      return std::nullopt;
+    }
+    auto const range = array.range_from(start, direction, false);
+    for (auto it = range.begin(); it != range.end(); ++it) {
+      if (predicate(*it)) {
+        return it.coords();
+      }
+    }
+    return std::nullopt;
+  }
+
+  template <typename T>
+  std::optional<Array2DCoords> find_next(Array2DBase<T> const& array,
+                                         Array2DCoords coords,
+                                         Direction direction,
+                                         std::type_identity_t<T> const& value) {
+    return find_next(array, coords, direction,
+                     [&value](T const& element) { return element == value; });
+  }
+
+}  // namespace cpp_utils
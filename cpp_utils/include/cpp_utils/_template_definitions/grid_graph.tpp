@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cpp_utils/grid_graph.hpp>
+
+#include <array>
+#include <stdexcept>
+#include <utility>
+
+namespace cpp_utils {
+
+  template <typename T, class IsOpen>
+  GridGraph contract_grid(Array2DBase<T> const& array,
+                          IsOpen is_open,
+                          std::vector<Array2DCoords> const& extra_nodes) {
+    // Finds the nodes, then walks each corridor leaving a node until the next node is reached.
+    // Corridors leading back to their own node are dropped, closed loops without any node are not
+    // part of the graph.
+    auto const num_rows = static_cast<Array2DDim>(array.num_rows());
+    auto const num_columns = static_cast<Array2DDim>(array.num_columns());
+    auto const index = [num_columns](Array2DCoords coords) {
+      return static_cast<size_t>(coords.row() * num_columns + coords.col());
+    };
+
+    std::vector<uint8_t> open(array.num_rows() * array.num_columns());
+    for (Array2DDim row = 0; row < num_rows; ++row) {
+      for (Array2DDim col = 0; col < num_columns; ++col) {
+        open[row * num_columns + col] = is_open(array(row, col)) ? 1 : 0;
+      }
+    }
+    auto open_neighbours = [&](Array2DCoords coords) {
+      std::array<Array2DCoords, 4> result;
+      size_t count = 0;
+      for (auto const& neighbour : get_direct_neighbour_coords(coords)) {
+        if (array.is_valid_index(neighbour) && open[index(neighbour)]) {
+          result[count++] = neighbour;
+        }
+      }
+      return std::make_pair(result, count);
+    };
+
+    std::vector<int32_t> node_at_cell(open.size(), -1);
+    std::vector<Array2DCoords> nodes;
+    auto add_node = [&](Array2DCoords coords) {
+      if (node_at_cell[index(coords)] < 0) {
+        node_at_cell[index(coords)] = static_cast<int32_t>(nodes.size());
+        nodes.push_back(coords);
+      }
+    };
+    for (auto const& coords : extra_nodes) {
+      if (!array.is_valid_index(coords) || !open[index(coords)]) {
+        throw std::invalid_argument("Extra nodes of a grid graph must be open cells");
+      }
+      add_node(coords);
+    }
+    for (Array2DDim row = 0; row < num_rows; ++row) {
+      for (Array2DDim col = 0; col < num_columns; ++col) {
+        auto const coords = Array2DCoords{row, col};
+        if (open[index(coords)] && open_neighbours(coords).second != 2) {
+          add_node(coords);
+        }
+      }
+    }
+
+    std::vector<std::vector<GridGraphEdge>> adjacency(nodes.size());
+    for (size_t node = 0; node < nodes.size(); ++node) {
+      auto const [first_steps, num_first_steps] = open_neighbours(nodes[node]);
+      for (size_t k = 0; k < num_first_steps; ++k) {
+        auto previous = nodes[node];
+        auto current = first_steps[k];
+        int64_t length = 1;
+        // Corridor cells have two open neighbours, continue with the one we did not come from
+        while (node_at_cell[index(current)] < 0) {
+          auto const [next_steps, _] = open_neighbours(current);
+          auto const next = next_steps[0] == previous ? next_steps[1] : next_steps[0];
+          previous = std::exchange(current, next);
+          ++length;
+        }
+        auto const target = static_cast<size_t>(node_at_cell[index(current)]);
+        if (target != node) {
+          adjacency[node].push_back(GridGraphEdge{target, length});
+        }
+      }
+    }
+
+    return GridGraph(array.dimensions(), std::move(nodes), adjacency);
+  }
+
+}  // namespace cpp_utils
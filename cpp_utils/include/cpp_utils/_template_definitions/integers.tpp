@@ -0,0 +1,149 @@
+// Implementation of the integer extraction.
+
+#pragma once
+
+#include <cpp_utils/integers.hpp>
+#include <fmt/format.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include <bit>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+namespace cpp_utils {
+
+  namespace _integers_detail {
+
+    inline bool is_digit(char c) { return static_cast<unsigned char>(c - '0') < 10; }
+
+    // Returns a pointer to the first character in [first, last) for which is_digit(c) == digit,
+    // or last. Classifies 16 characters at once if SSE2 is available.
+    template <bool Digit>
+    char const* find_digit_class(char const* first, char const* last) {
+#if defined(__SSE2__)
+      auto const below_zero = _mm_set1_epi8('0' - 1);
+      auto const above_nine = _mm_set1_epi8('9' + 1);
+      while (last - first >= 16) {
+        auto const chunk = _mm_loadu_si128(reinterpret_cast<__m128i const*>(first));
+        // Signed comparison: bytes >= 0x80 are negative and thus no digits
+        auto const digits =
+            _mm_and_si128(_mm_cmpgt_epi8(chunk, below_zero), _mm_cmplt_epi8(chunk, above_nine));
+        auto mask = static_cast<unsigned>(_mm_movemask_epi8(digits));
+        if constexpr (!Digit) {
+          mask = ~mask & 0xFFFFu;
+        }
+        if (mask != 0) {
+          return first + std::countr_zero(mask);
+        }
+        first += 16;
+      }
+#endif
+      while (first != last && is_digit(*first) != Digit) {
+        ++first;
+      }
+      return first;
+    }
+
+    // Converts exactly 8 digits with a few multiplications (SWAR)
+    inline uint64_t parse_eight_digits(char const* digits) {
+      uint64_t value;
+      std::memcpy(&value, digits, sizeof(value));
+      value -= 0x3030303030303030;
+      value = (value * 10) + (value >> 8);
+      value = (((value & 0x000000FF000000FF) * (100 + (1000000ULL << 32))) +
+               (((value >> 16) & 0x000000FF000000FF) * (1 + (10000ULL << 32)))) >>
+              32;
+      return value;
+    }
+
+    // Converts the digit run [first, last), which must fit into T
+    template <typename T>
+    T convert_digits(char const* first, char const* last, bool negative) {
+      using Unsigned = std::make_unsigned_t<T>;
+      auto const length = last - first;
+      if (length > std::numeric_limits<T>::digits10) {
+        // Might overflow, let from_chars do the range check
+        T value{};
+        auto const result = std::from_chars(negative ? first - 1 : first, last, value);
+        if (result.ec != std::errc()) {
+          throw std::out_of_range(
+              fmt::format("Integer {} out of range", std::string_view(first, last)));
+        }
+        return value;
+      }
+      Unsigned value = 0;
+      if constexpr (std::endian::native == std::endian::little && sizeof(T) >= 4) {
+        while (last - first >= 8) {
+          value = value * 100000000 + static_cast<Unsigned>(parse_eight_digits(first));
+          first += 8;
+        }
+      }
+      for (; first != last; ++first) {
+        value = value * 10 + static_cast<Unsigned>(*first - '0');
+      }
+      return negative ? static_cast<T>(Unsigned{0} - value) : static_cast<T>(value);
+    }
+
+    // Calls f(integer) for each integer of text
+    template <typename T, class F>
+    void for_each_integer(std::string_view text, F&& f) {
+      char const* const begin = text.data();
+      char const* const end = text.data() + text.size();
+      char const* position = begin;
+      while (true) {
+        auto const* const first = find_digit_class<true>(position, end);
+        if (first == end) {
+          return;
+        }
+        auto const* const last = find_digit_class<false>(first, end);
+        bool negative = false;
+        if constexpr (std::is_signed_v<T>) {
+          negative = first != begin && first[-1] == '-';
+        }
+        f(convert_digits<T>(first, last, negative));
+        position = last;
+      }
+    }
+
+  }  // namespace _integers_detail
+
+  template <typename T>
+  std::vector<T> extract_integers(std::string_view text) {
+    std::vector<T> result;
+    _integers_detail::for_each_integer<T>(text, [&result](T value) { result.push_back(value); });
+    return result;
+  }
+
+  template <typename T>
+  size_t extract_integers(std::string_view text, std::span<T> out) {
+    size_t count = 0;
+    _integers_detail::for_each_integer<T>(text, [&out, &count](T value) {
+      if (count == out.size()) {
+        throw std::length_error(
+            fmt::format("Text contains more than {} integers", out.size()));
+      }
+      out[count++] = value;
+    });
+    return count;
+  }
+
+  template <typename T>
+  std::vector<std::vector<T>> extract_integers_per_line(std::string_view text) {
+    std::vector<std::vector<T>> result;
+    while (!text.empty()) {
+      auto const line_end = text.find('\n');
+      auto const line = text.substr(0, line_end);
+      result.push_back(extract_integers<T>(line));
+      text = line_end == std::string_view::npos ? std::string_view() : text.substr(line_end + 1);
+    }
+    return result;
+  }
+
+}  // namespace cpp_utils
@@ -0,0 +1,178 @@
+// Implementation of IntervalMap class template.
+
+#pragma once
+
+#include <cpp_utils/interval_map.hpp>
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+
+namespace cpp_utils {
+
+  namespace _interval_map_detail {
+
+    template <typename T>
+    void check_source(std::pair<T, T> const& source) {
+      if (source.first > source.second) {
+        throw std::invalid_argument(fmt::format("Rule source start {} must not exceed end {}.",
+                                                source.first, source.second));
+      }
+    }
+
+    // lhs must start before rhs
+    template <typename T>
+    void check_disjoint(std::pair<T, T> const& lhs, std::pair<T, T> const& rhs) {
+      if (lhs.second >= rhs.first) {
+        throw std::invalid_argument(fmt::format("Rule sources [{}, {}] and [{}, {}] overlap.",
+                                                lhs.first, lhs.second, rhs.first, rhs.second));
+      }
+    }
+
+  }  // namespace _interval_map_detail
+
+  template <typename T>
+  IntervalMap<T>::IntervalMap(std::vector<Rule> rules) : rules_(std::move(rules)) {
+    normalize();
+  }
+
+  template <typename T>
+  void IntervalMap<T>::insert_rule(Interval source, T offset) {
+    // The rules are kept sorted and disjoint, so only the neighbours of the insert position are
+    // checked and possibly merged instead of normalizing all rules again
+    _interval_map_detail::check_source(source);
+    auto next = std::ranges::partition_point(
+        rules_, [&source](Rule const& rule) { return rule.source.first < source.first; });
+    if (next != rules_.end()) {
+      _interval_map_detail::check_disjoint(source, next->source);
+    }
+    if (next != rules_.begin()) {
+      auto previous = std::prev(next);
+      _interval_map_detail::check_disjoint(previous->source, source);
+      if (previous->source.second + 1 == source.first && previous->offset == offset) {
+        previous->source.second = source.second;
+        if (next != rules_.end() && source.second + 1 == next->source.first &&
+            next->offset == offset) {
+          previous->source.second = next->source.second;
+          rules_.erase(next);
+        }
+        return;
+      }
+    }
+    if (next != rules_.end() && source.second + 1 == next->source.first && next->offset == offset) {
+      next->source.first = source.first;
+      return;
+    }
+    rules_.insert(next, Rule{source, offset});
+  }
+
+  template <typename T>
+  void IntervalMap<T>::insert_rules(std::vector<Rule> const& rules) {
+    rules_.insert(rules_.end(), rules.begin(), rules.end());
+    normalize();
+  }
+
+  template <typename T>
+  void IntervalMap<T>::normalize() {
+    std::ranges::sort(rules_, {}, &Rule::source);
+    std::vector<Rule> normalized;
+    normalized.reserve(rules_.size());
+    for (auto const& rule : rules_) {
+      _interval_map_detail::check_source(rule.source);
+      if (!normalized.empty()) {
+        auto& last = normalized.back();
+        _interval_map_detail::check_disjoint(last.source, rule.source);
+        if (last.source.second + 1 == rule.source.first && last.offset == rule.offset) {
+          last.source.second = rule.source.second;
+          continue;
+        }
+      }
+      normalized.push_back(rule);
+    }
+    rules_ = std::move(normalized);
+  }
+
+  template <typename T>
+  template <class F>
+  void IntervalMap<T>::for_each_piece(T start, T end, RuleIterator& rule, F&& f) const {
+    while (rule != rules_.end() && rule->source.second < start) {
+      ++rule;
+    }
+    auto current = start;
+    while (true) {
+      bool const inside_rule = rule != rules_.end() && rule->source.first <= current;
+      T piece_end;
+      T offset = 0;
+      if (inside_rule) {
+        piece_end = std::min(end, rule->source.second);
+        offset = rule->offset;
+      } else if (rule != rules_.end() && rule->source.first <= end) {
+        // Gap up to the next rule
+        piece_end = rule->source.first - 1;
+      } else {
+        piece_end = end;
+      }
+      f(current, piece_end, offset);
+      // Stop before computing piece_end + 1, which could overflow
+      if (piece_end == end) {
+        return;
+      }
+      if (inside_rule) {
+        ++rule;
+      }
+      current = piece_end + 1;
+    }
+  }
+
+  template <typename T>
+  T IntervalMap<T>::operator()(T value) const {
+    auto it = std::ranges::partition_point(
+        rules_, [value](Rule const& rule) { return rule.source.second < value; });
+    if (it != rules_.end() && it->source.first <= value) {
+      return value + it->offset;
+    }
+    return value;
+  }
+
+  template <typename T>
+  Intervals<T> IntervalMap<T>::transform(Intervals<T> const& intervals) const {
+    // Both the intervals and the rules are sorted, so one rule iterator is shared by all
+    // intervals. The shifted pieces are no longer sorted, Intervals sorts and merges them once.
+    std::vector<Interval> pieces;
+    auto rule = rules_.begin();
+    for (auto const& [start, end] : intervals.intervals()) {
+      for_each_piece(start, end, rule, [&pieces](T piece_start, T piece_end, T offset) {
+        pieces.emplace_back(piece_start + offset, piece_end + offset);
+      });
+    }
+    return Intervals<T>(std::move(pieces));
+  }
+
+  template <typename T>
+  IntervalMap<T> IntervalMap<T>::then(IntervalMap const& next) const {
+    // Split the whole domain into pieces of this map, then split the image of each piece by the
+    // rules of next. Pieces with a total offset of 0 are identity and need no rule.
+    std::vector<Rule> composed;
+    auto add_pieces = [&next, &composed](T piece_start, T piece_end, T offset) {
+      auto next_rule = std::ranges::partition_point(
+          next.rules_, [image_start = piece_start + offset](Rule const& next_rule) {
+            return next_rule.source.second < image_start;
+          });
+      next.for_each_piece(piece_start + offset, piece_end + offset, next_rule,
+                          [offset, &composed](T image_start, T image_end, T next_offset) {
+                            if (offset + next_offset != 0) {
+                              composed.push_back(
+                                  Rule{{image_start - offset, image_end - offset},
+                                       offset + next_offset});
+                            }
+                          });
+    };
+    auto rule = rules_.begin();
+    for_each_piece(std::numeric_limits<T>::lowest(), std::numeric_limits<T>::max(), rule,
+                   add_pieces);
+    return IntervalMap(std::move(composed));
+  }
+
+}  // namespace cpp_utils
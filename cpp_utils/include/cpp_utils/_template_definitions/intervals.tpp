@@ -2,19 +2,114 @@
 
 #pragma once
 
+#include <cpp_utils/instrumentation.hpp>
 #include <cpp_utils/intervals.hpp>
 #include <fmt/format.h>
 
 #include <algorithm>
+#include <cstddef>
+#include <iterator>
 #include <stdexcept>
 
 namespace cpp_utils {
 
+  namespace _intervals_detail {
+
+    template <typename T>
+    void check_interval(T start, T end) {
+      if (start > end) {
+        throw std::invalid_argument(
+            fmt::format("Interval start {} must be less than or equal to end {}.", start, end));
+      }
+    }
+
+    // Merges overlapping intervals of a list sorted by start in a single sweep
+    template <typename T>
+    void merge_sorted(std::vector<std::pair<T, T>>& intervals) {
+      if (intervals.empty()) {
+        return;
+      }
+      // Each interval is merged into the last written one if they overlap
+      auto out = intervals.begin();
+      for (auto it = std::next(intervals.begin()); it != intervals.end(); ++it) {
+        if (it->first <= out->second) {
+          out->second = std::max(out->second, it->second);
+        } else {
+          *(++out) = *it;
+        }
+      }
+      intervals.erase(std::next(out), intervals.end());
+    }
+
+    // Appends the intersection of two sorted lists of disjoint intervals to out
+    template <typename T>
+    void intersect_sorted(std::vector<std::pair<T, T>> const& lhs,
+                          std::vector<std::pair<T, T>> const& rhs,
+                          std::vector<std::pair<T, T>>& out) {
+      auto left = lhs.begin();
+      auto right = rhs.begin();
+      while (left != lhs.end() && right != rhs.end()) {
+        auto const start = std::max(left->first, right->first);
+        auto const end = std::min(left->second, right->second);
+        if (start <= end) {
+          out.emplace_back(start, end);
+        }
+        // The interval which ends first cannot overlap with anything else
+        if (left->second < right->second) {
+          ++left;
+        } else {
+          ++right;
+        }
+      }
+    }
+
+    // Appends lhs without rhs to out, both sorted lists of disjoint intervals
+    template <typename T>
+    void subtract_sorted(std::vector<std::pair<T, T>> const& lhs,
+                         std::vector<std::pair<T, T>> const& rhs,
+                         std::vector<std::pair<T, T>>& out) {
+      auto right = rhs.begin();
+      for (auto const& [start, end] : lhs) {
+        // Skip the intervals of rhs which end before this one
+        while (right != rhs.end() && right->second < start) {
+          ++right;
+        }
+        auto current = start;
+        bool covered_to_end = false;
+        // The last interval of rhs visited here may overlap the next interval of lhs as well,
+        // so do not advance right itself
+        for (auto it = right; it != rhs.end() && it->first <= end; ++it) {
+          if (it->first > current) {
+            out.emplace_back(current, it->first - 1);
+          }
+          if (it->second >= end) {
+            covered_to_end = true;
+            break;
+          }
+          current = std::max(current, it->second + 1);
+        }
+        if (!covered_to_end) {
+          out.emplace_back(current, end);
+        }
+      }
+    }
+
+  }  // namespace _intervals_detail
+
   template <typename T>
-  Intervals<T>::Intervals(std::vector<Interval> intervals) {
-    for (auto const& interval : intervals) {
-      insert_interval(interval.first, interval.second);
+  Intervals<T>::Intervals(std::vector<Interval> intervals) : intervals_(std::move(intervals)) {
+    for (auto const& interval : intervals_) {
+      _intervals_detail::check_interval(interval.first, interval.second);
     }
+    sort_and_merge(intervals_);
+  }
+
+  template <typename T>
+  void Intervals<T>::sort_and_merge(std::vector<Interval>& intervals) {
+    CPP_UTILS_SCOPED_TIMER("intervals.sort_and_merge");
+    CPP_UTILS_HISTOGRAM("intervals.sort_and_merge_size", intervals.size());
+    std::ranges::sort(intervals);
+    _intervals_detail::merge_sorted(intervals);
   }
 
   template <typename T>
@@ -33,43 +128,133 @@ namespace cpp_utils {
     //   end: end of the interval
     // Note: the exisitng intervals are assumed to be non-overlapping.
 
-    if (start > end) {
-      throw std::invalid_argument(
-          fmt::format("Interval start {} must be less than or equal to end {}.", start, end));
+    _intervals_detail::check_interval(start, end);
+
+    // Since the intervals are disjoint, both their starts and ends are sorted.
+    // first: first interval which ends at or after start
+    // last: first interval which starts after end
+    auto first = std::ranges::partition_point(
+        intervals_, [start](Interval const& interval) { return interval.second < start; });
+    auto last = std::partition_point(first, intervals_.end(), [end](Interval const& interval) {
+      return interval.first <= end;
+    });
+
+    if (first == last) {
+      intervals_.emplace(first, start, end);
+      return;
     }
+    // Merge all overlapping intervals into the first one
+    CPP_UTILS_COUNT("intervals.merged_on_insert", last - first);
+    first->first = std::min(start, first->first);
+    first->second = std::max(end, std::prev(last)->second);
+    intervals_.erase(std::next(first), last);
+  }
 
-    // Find the first interval whose start (key) is greater than the new interval's end
-    // i.e. it->first > end
-    auto it = intervals_.upper_bound(end);
+  template <typename T>
+  void Intervals<T>::insert_interval_deferred(T start, T end) {
+    _intervals_detail::check_interval(start, end);
+    pending_.emplace_back(start, end);
+  }
 
-    // This interval certainly doesn't overlap with the new interval
-    // so go back one to check for overlapping intervals
-    if (it != intervals_.begin()) {
-      --it;
+  template <typename T>
+  void Intervals<T>::merge_pending() const {
+    // Merge the deferred intervals with the existing ones in one linear pass
+    if (pending_.empty()) {
+      return;
     }
+    sort_and_merge(pending_);
+    std::vector<Interval> merged;
+    merged.reserve(intervals_.size() + pending_.size());
+    std::ranges::merge(intervals_, pending_, std::back_inserter(merged));
+    _intervals_detail::merge_sorted(merged);
+    intervals_ = std::move(merged);
+    pending_.clear();
+  }
 
-    while (it != intervals_.end() && it->first <= end && it->second >= start) {
-      // Merge overlapping intervals
-      start = std::min(start, it->first);
-      end = std::max(end, it->second);
-      // Erase the overlapping interval
-      intervals_.erase(it);
-      // Cannot reuse the iterator after erasing, so find the next interval again
-      it = intervals_.upper_bound(end);
-      if (it != intervals_.begin()) {
-        --it;
-      }
+  template <typename T>
+  Intervals<T> Intervals<T>::from_sorted(std::vector<Interval> intervals) {
+    Intervals result;
+    result.intervals_ = std::move(intervals);
+    return result;
+  }
+
+  template <typename T>
+  Intervals<T> Intervals<T>::operator|(Intervals const& other) const {
+    auto const& lhs = intervals();
+    auto const& rhs = other.intervals();
+    std::vector<Interval> result;
+    result.reserve(lhs.size() + rhs.size());
+    std::ranges::merge(lhs, rhs, std::back_inserter(result));
+    _intervals_detail::merge_sorted(result);
+    return from_sorted(std::move(result));
+  }
+
+  template <typename T>
+  Intervals<T> Intervals<T>::operator&(Intervals const& other) const {
+    std::vector<Interval> result;
+    _intervals_detail::intersect_sorted(intervals(), other.intervals(), result);
+    return from_sorted(std::move(result));
+  }
+
+  template <typename T>
+  Intervals<T> Intervals<T>::operator-(Intervals const& other) const {
+    std::vector<Interval> result;
+    _intervals_detail::subtract_sorted(intervals(), other.intervals(), result);
+    return from_sorted(std::move(result));
+  }
+
+  template <typename T>
+  Intervals<T>& Intervals<T>::operator|=(Intervals const& other) {
+    // Append and merge the two sorted halves within the existing storage
+    merge_pending();
+    if (&other == this) {
+      return *this;
     }
-    intervals_.emplace(start, end);
+    auto const& rhs = other.intervals();
+    auto const middle = static_cast<std::ptrdiff_t>(intervals_.size());
+    intervals_.insert(intervals_.end(), rhs.begin(), rhs.end());
+    std::inplace_merge(intervals_.begin(), intervals_.begin() + middle, intervals_.end());
+    _intervals_detail::merge_sorted(intervals_);
+    return *this;
+  }
+
+  template <typename T>
+  Intervals<T>& Intervals<T>::operator&=(Intervals const& other) {
+    // The result may contain more intervals than this set, so it is written to the pending buffer
+    // (empty after flushing) and the buffers are swapped afterwards.
+    merge_pending();
+    _intervals_detail::intersect_sorted(intervals_, other.intervals(), pending_);
+    intervals_.swap(pending_);
+    pending_.clear();
+    return *this;
+  }
+
+  template <typename T>
+  Intervals<T>& Intervals<T>::operator-=(Intervals const& other) {
+    merge_pending();
+    _intervals_detail::subtract_sorted(intervals_, other.intervals(), pending_);
+    intervals_.swap(pending_);
+    pending_.clear();
+    return *this;
+  }
+
+  template <typename T>
+  Intervals<T> Intervals<T>::complement(T lower, T upper) const {
+    _intervals_detail::check_interval(lower, upper);
+    std::vector<Interval> bounds = {{lower, upper}};
+    std::vector<Interval> result;
+    _intervals_detail::subtract_sorted(bounds, intervals(), result);
+    return from_sorted(std::move(result));
   }
 
   template <typename T>
   bool Intervals<T>::contains(T value) const {
     // Check if the value is contained in any of the intervals
+    merge_pending();
 
-    // Find the first interval whose start (key) is greater than the value
-    // i.e. it->first > value
-    auto it = intervals_.upper_bound(value);
+    // Find the first interval whose start is greater than the value
+    auto it = std::ranges::partition_point(
+        intervals_, [value](Interval const& interval) { return interval.first <= value; });
 
     // If this is the first interval, the value is not contained in any interval
     if (it == intervals_.begin()) {
@@ -78,12 +263,74 @@ namespace cpp_utils {
 
     // Go back one to check if the value is in the previous interval
     --it;
-    return it->first <= value && it->second >= value;
+    return it->second >= value;
+  }
+
+  template <typename T>
+  template <class F>
+  void Intervals<T>::for_each_membership(std::span<T const> values, F&& f) const {
+    merge_pending();
+    if (std::ranges::is_sorted(values)) {
+      // Walk through values and intervals simultaneously
+      auto it = intervals_.begin();
+      for (size_t index = 0; index < values.size(); ++index) {
+        auto const value = values[index];
+        while (it != intervals_.end() && it->second < value) {
+          ++it;
+        }
+        f(index, it != intervals_.end() && it->first <= value);
+      }
+      return;
+    }
+
+    // Separate arrays of starts and ends keep the binary search within dense memory
+    std::vector<T> starts;
+    std::vector<T> ends;
+    starts.reserve(intervals_.size());
+    ends.reserve(intervals_.size());
+    for (auto const& [start, end] : intervals_) {
+      starts.push_back(start);
+      ends.push_back(end);
+    }
+    for (size_t index = 0; index < values.size(); ++index) {
+      auto const value = values[index];
+      if (starts.empty()) {
+        f(index, false);
+        continue;
+      }
+      // Branchless search for the last start <= value, the loop length only depends on the
+      // number of intervals and the conditional move replaces the unpredictable branch
+      T const* base = starts.data();
+      size_t length = starts.size();
+      while (length > 1) {
+        auto const half = length / 2;
+        base = base[half] <= value ? base + half : base;
+        length -= half;
+      }
+      auto const num_starts_le_value = static_cast<size_t>(base - starts.data()) + (*base <= value);
+      f(index, num_starts_le_value > 0 && ends[num_starts_le_value - 1] >= value);
+    }
+  }
+
+  template <typename T>
+  std::vector<bool> Intervals<T>::contains(std::span<T const> values) const {
+    std::vector<bool> result(values.size());
+    for_each_membership(values,
+                        [&result](size_t index, bool contained) { result[index] = contained; });
+    return result;
+  }
+
+  template <typename T>
+  size_t Intervals<T>::count_contained(std::span<T const> values) const {
+    size_t count = 0;
+    for_each_membership(values, [&count](size_t, bool contained) { count += contained; });
+    return count;
   }
 
   template <typename T>
   T Intervals<T>::total_area() const {
     // Calculate the total area covered by all intervals
+    merge_pending();
     return std::ranges::fold_left(intervals_, static_cast<T>(0), [](T acc, auto const& interval) {
       return acc + (interval.second - interval.first + 1);
     });
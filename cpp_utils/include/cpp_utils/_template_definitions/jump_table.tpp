@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cpp_utils/jump_table.hpp>
+
+namespace cpp_utils {
+
+  namespace _jump_table_detail {
+
+    template <typename T, class IsObstacle>
+    std::vector<uint8_t> find_obstacles(Array2DBase<T> const& array, IsObstacle& is_obstacle) {
+      std::vector<uint8_t> obstacles(array.num_rows() * array.num_columns());
+      for (size_t row = 0; row < array.num_rows(); ++row) {
+        for (size_t col = 0; col < array.num_columns(); ++col) {
+          obstacles[row * array.num_columns() + col] = is_obstacle(array(row, col)) ? 1 : 0;
+        }
+      }
+      return obstacles;
+    }
+
+  }  // namespace _jump_table_detail
+
+  template <typename T, class IsObstacle>
+  JumpTable2D::JumpTable2D(Array2DBase<T> const& array, IsObstacle is_obstacle)
+      : JumpTable2D(array.dimensions(), _jump_table_detail::find_obstacles(array, is_obstacle)) {}
+
+}  // namespace cpp_utils
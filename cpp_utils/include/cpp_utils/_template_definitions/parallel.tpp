@@ -0,0 +1,72 @@
+// Implementation of the parallel parse drivers.
+
+#pragma once
+
+#include <cpp_utils/input.hpp>
+#include <cpp_utils/parallel.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <optional>
+#include <utility>
+
+namespace cpp_utils {
+
+  namespace _parallel_detail {
+
+    inline size_t default_num_chunks(ThreadPool const& pool) { return 4 * pool.num_threads(); }
+
+  }  // namespace _parallel_detail
+
+  template <class F>
+  auto parallel_parse_chunks(std::string_view input,
+                             F const& parse_chunk,
+                             ThreadPool& pool,
+                             size_t num_chunks)
+      -> std::vector<std::invoke_result_t<F const&, std::string_view>> {
+    using Result = std::invoke_result_t<F const&, std::string_view>;
+    auto const chunks = split_into_chunks(
+        input, num_chunks == 0 ? _parallel_detail::default_num_chunks(pool) : num_chunks);
+    // Results are not required to be default constructible
+    std::vector<std::optional<Result>> results(chunks.size());
+    pool.run(chunks.size(),
+             [&](size_t chunk) { results[chunk].emplace(parse_chunk(chunks[chunk])); });
+
+    std::vector<Result> ordered;
+    ordered.reserve(results.size());
+    for (auto& result : results) {
+      ordered.push_back(std::move(*result));
+    }
+    return ordered;
+  }
+
+  template <class F>
+  auto parallel_parse_lines(std::string_view input, F const& parse_line, ThreadPool& pool)
+      -> std::vector<std::invoke_result_t<F const&, std::string_view>> {
+    using Result = std::invoke_result_t<F const&, std::string_view>;
+    auto chunk_results = parallel_parse_chunks(
+        input,
+        [&parse_line](std::string_view chunk) {
+          std::vector<Result> results;
+          for (auto const line : split_view(chunk, '\n')) {
+            if (!line.empty()) {
+              results.push_back(parse_line(line));
+            }
+          }
+          return results;
+        },
+        pool);
+
+    size_t total = 0;
+    for (auto const& results : chunk_results) {
+      total += results.size();
+    }
+    std::vector<Result> concatenated;
+    concatenated.reserve(total);
+    for (auto& results : chunk_results) {
+      std::ranges::move(results, std::back_inserter(concatenated));
+    }
+    return concatenated;
+  }
+
+}  // namespace cpp_utils
@@ -0,0 +1,110 @@
+// Implementation of the polygon measures.
+
+#pragma once
+
+#include <cpp_utils/polygon.hpp>
+#include <fmt/format.h>
+
+#include <stdexcept>
+#include <utility>
+
+namespace cpp_utils {
+
+  namespace _polygon_detail {
+
+    inline PolygonInt abs(PolygonInt value) { return value < 0 ? -value : value; }
+
+    // std::gcd is not defined for __int128 in strict standard mode
+    inline PolygonInt gcd(PolygonInt a, PolygonInt b) {
+      a = abs(a);
+      b = abs(b);
+      while (b != 0) {
+        a = std::exchange(b, a % b);
+      }
+      return a;
+    }
+
+    // 128-bit arithmetic which throws std::overflow_error instead of wrapping around
+    inline PolygonInt checked_multiply(PolygonInt a, PolygonInt b) {
+      PolygonInt result;
+      if (__builtin_mul_overflow(a, b, &result)) {
+        throw std::overflow_error("Polygon coordinates are too large for 128-bit arithmetic");
+      }
+      return result;
+    }
+
+    inline PolygonInt checked_add(PolygonInt a, PolygonInt b) {
+      PolygonInt result;
+      if (__builtin_add_overflow(a, b, &result)) {
+        throw std::overflow_error("Polygon coordinates are too large for 128-bit arithmetic");
+      }
+      return result;
+    }
+
+    // Accumulates the shoelace sum and the boundary points edge by edge
+    class PolygonAccumulator {
+     public:
+      void add_edge(PolygonInt row, PolygonInt col, PolygonInt next_row, PolygonInt next_col) {
+        auto const term = checked_add(checked_multiply(row, next_col),
+                                      -checked_multiply(next_row, col));
+        twice_signed_area_ = checked_add(twice_signed_area_, term);
+        boundary_points_ += gcd(next_row - row, next_col - col);
+        has_vertex_ = true;
+      }
+
+      PolygonMeasures result() const {
+        PolygonMeasures measures;
+        // Negating the smallest 128-bit value overflows as well
+        measures.twice_area = checked_multiply(twice_signed_area_, twice_signed_area_ < 0 ? -1 : 1);
+        // All edges have length zero for a single point
+        measures.boundary_points = has_vertex_ && boundary_points_ == 0 ? 1 : boundary_points_;
+        // Pick's theorem: 2A = 2I + B - 2, a single point is the only simple polygon without area
+        if (measures.twice_area > 0) {
+          measures.interior_points = (measures.twice_area - boundary_points_ + 2) / 2;
+        }
+        return measures;
+      }
+
+     private:
+      PolygonInt twice_signed_area_ = 0;
+      PolygonInt boundary_points_ = 0;
+      bool has_vertex_ = false;
+    };
+
+  }  // namespace _polygon_detail
+
+  template <typename T>
+  PolygonMeasures measure_polygon(std::vector<Coords2D<T>> const& vertices) {
+    _polygon_detail::PolygonAccumulator accumulator;
+    for (size_t i = 0; i < vertices.size(); ++i) {
+      auto const& current = vertices[i];
+      auto const& next = vertices[(i + 1) % vertices.size()];
+      accumulator.add_edge(current.row(), current.col(), next.row(), next.col());
+    }
+    return accumulator.result();
+  }
+
+  template <typename T>
+  PolygonMeasures measure_polygon(std::vector<std::pair<Direction, T>> const& moves) {
+    // The vertices are only needed pairwise, so they are tracked on the way
+    _polygon_detail::PolygonAccumulator accumulator;
+    PolygonInt row = 0;
+    PolygonInt col = 0;
+    for (auto const& [direction, length] : moves) {
+      if (length < 0) {
+        throw std::invalid_argument(fmt::format("Move length {} must not be negative", length));
+      }
+      auto const step = Coords2D<int>{0, 0}.step_towards_direction(direction);
+      auto const next_row = row + static_cast<PolygonInt>(step.row()) * length;
+      auto const next_col = col + static_cast<PolygonInt>(step.col()) * length;
+      accumulator.add_edge(row, col, next_row, next_col);
+      row = next_row;
+      col = next_col;
+    }
+    if (row != 0 || col != 0) {
+      throw std::invalid_argument("Moves do not return to the starting point");
+    }
+    return accumulator.result();
+  }
+
+}  // namespace cpp_utils
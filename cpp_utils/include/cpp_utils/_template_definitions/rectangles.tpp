@@ -0,0 +1,188 @@
+// Implementation of the rectangle sweep line.
+
+#pragma once
+
+#include <cpp_utils/rectangles.hpp>
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace cpp_utils {
+
+  namespace _rectangles_detail {
+
+    // Segment tree over the elementary column segments [columns[i], columns[i + 1]). Each node
+    // stores how often it is covered as a whole and, for j = 1..k, the length within the node
+    // which is covered at least j times by the node and its descendants.
+    template <typename T>
+    class CoverageTree {
+     public:
+      CoverageTree(std::vector<T> columns, size_t k)
+          : columns_(std::move(columns)),
+            k_(k),
+            count_(4 * columns_.size(), 0),
+            at_least_(4 * columns_.size() * k, 0) {}
+
+      size_t num_segments() const { return columns_.size() - 1; }
+
+      // Adds delta to the coverage of the columns [columns[first], columns[last])
+      void update(size_t first, size_t last, int delta) {
+        update(1, 0, num_segments(), first, last, delta);
+      }
+
+      // Length covered at least k times
+      T covered() const { return at_least(1, k_); }
+
+      // Appends the column intervals covered at least k times, adjacent intervals are joined
+      void collect(std::vector<std::pair<T, T>>& out) const {
+        collect(1, 0, num_segments(), 0, out);
+      }
+
+     private:
+      T& at_least(size_t node, size_t j) { return at_least_[node * k_ + j - 1]; }
+      T at_least(size_t node, size_t j) const { return at_least_[node * k_ + j - 1]; }
+
+      void pull(size_t node, size_t low, size_t high) {
+        for (size_t j = 1; j <= k_; ++j) {
+          if (count_[node] >= static_cast<int64_t>(j)) {
+            at_least(node, j) = columns_[high] - columns_[low];
+          } else if (high - low == 1) {
+            at_least(node, j) = 0;
+          } else {
+            auto const remaining = j - static_cast<size_t>(count_[node]);
+            at_least(node, j) = at_least(2 * node, remaining) + at_least(2 * node + 1, remaining);
+          }
+        }
+      }
+
+      void update(size_t node, size_t low, size_t high, size_t first, size_t last, int delta) {
+        if (last <= low || high <= first) {
+          return;
+        }
+        if (first <= low && high <= last) {
+          count_[node] += delta;
+        } else {
+          auto const middle = (low + high) / 2;
+          update(2 * node, low, middle, first, last, delta);
+          update(2 * node + 1, middle, high, first, last, delta);
+        }
+        pull(node, low, high);
+      }
+
+      void collect(size_t node,
+                   size_t low,
+                   size_t high,
+                   int64_t inherited,
+                   std::vector<std::pair<T, T>>& out) const {
+        auto const total = inherited + count_[node];
+        if (total >= static_cast<int64_t>(k_)) {
+          // Columns are half-open here, intervals are closed
+          if (!out.empty() && out.back().second + 1 == columns_[low]) {
+            out.back().second = columns_[high] - 1;
+          } else {
+            out.emplace_back(columns_[low], columns_[high] - 1);
+          }
+          return;
+        }
+        if (high - low == 1 || at_least(node, k_ - static_cast<size_t>(total)) == 0) {
+          return;
+        }
+        auto const middle = (low + high) / 2;
+        collect(2 * node, low, middle, total, out);
+        collect(2 * node + 1, middle, high, total, out);
+      }
+
+      std::vector<T> columns_;
+      size_t k_;
+      std::vector<int64_t> count_;
+      std::vector<T> at_least_;
+    };
+
+    // Sweeps over the rows and calls on_band(first_row, end_row, tree) for each band of rows
+    // [first_row, end_row) with the same coverage
+    template <typename T, class F>
+    void sweep(std::vector<Rectangle<T>> const& rectangles, size_t k, F&& on_band) {
+      if (k == 0) {
+        throw std::invalid_argument("Coverage count k must be at least 1");
+      }
+      struct Event {
+        T row;
+        T first_column;
+        T end_column;
+        int delta;
+      };
+      std::vector<Event> events;
+      std::vector<T> columns;
+      events.reserve(2 * rectangles.size());
+      columns.reserve(2 * rectangles.size());
+      for (auto const& [upper_left, lower_right] : rectangles) {
+        if (upper_left.row() > lower_right.row() || upper_left.col() > lower_right.col()) {
+          throw std::invalid_argument(fmt::format(
+              "Rectangle corners ({}, {}) and ({}, {}) are not upper left and lower right",
+              upper_left.row(), upper_left.col(), lower_right.row(), lower_right.col()));
+        }
+        // Rows and columns are half-open from here on
+        events.push_back(Event{upper_left.row(), upper_left.col(), lower_right.col() + 1, 1});
+        events.push_back(
+            Event{lower_right.row() + 1, upper_left.col(), lower_right.col() + 1, -1});
+        columns.push_back(upper_left.col());
+        columns.push_back(lower_right.col() + 1);
+      }
+      if (events.empty()) {
+        return;
+      }
+      std::ranges::sort(columns);
+      columns.erase(std::unique(columns.begin(), columns.end()), columns.end());
+      std::ranges::sort(events, {}, &Event::row);
+
+      auto const column_index = [&columns](T column) {
+        return static_cast<size_t>(std::ranges::lower_bound(columns, column) - columns.begin());
+      };
+      CoverageTree<T> tree(columns, k);
+      auto previous_row = events.front().row;
+      for (auto const& event : events) {
+        if (event.row != previous_row) {
+          on_band(previous_row, event.row, tree);
+          previous_row = event.row;
+        }
+        tree.update(column_index(event.first_column), column_index(event.end_column), event.delta);
+      }
+    }
+
+  }  // namespace _rectangles_detail
+
+  template <typename T>
+  T rectangle_union_area(std::vector<Rectangle<T>> const& rectangles) {
+    return rectangle_area_covered_at_least(rectangles, 1);
+  }
+
+  template <typename T>
+  T rectangle_area_covered_at_least(std::vector<Rectangle<T>> const& rectangles, size_t k) {
+    T area = 0;
+    _rectangles_detail::sweep(
+        rectangles, k,
+        [&area](T first_row, T end_row, _rectangles_detail::CoverageTree<T> const& tree) {
+          area += tree.covered() * (end_row - first_row);
+        });
+    return area;
+  }
+
+  template <typename T>
+  std::vector<RowCoverage<T>> rectangle_row_coverage(std::vector<Rectangle<T>> const& rectangles,
+                                                     size_t k) {
+    std::vector<RowCoverage<T>> result;
+    _rectangles_detail::sweep(
+        rectangles, k,
+        [&result](T first_row, T end_row, _rectangles_detail::CoverageTree<T> const& tree) {
+          if (tree.covered() == 0) {
+            return;
+          }
+          std::vector<std::pair<T, T>> columns;
+          tree.collect(columns);
+          result.push_back(RowCoverage<T>{{first_row, end_row - 1}, Intervals<T>(columns)});
+        });
+    return result;
+  }
+
+}  // namespace cpp_utils
@@ -0,0 +1,197 @@
+// Implementation of the pattern scanner.
+
+#pragma once
+
+#include <cpp_utils/input.hpp>
+#include <cpp_utils/scan.hpp>
+#include <fmt/format.h>
+
+#include <array>
+#include <charconv>
+#include <type_traits>
+#include <utility>
+
+namespace cpp_utils {
+
+  namespace _scan_detail {
+
+    // Literal part of a pattern as offset and length into the pattern
+    struct Segment {
+      size_t offset;
+      size_t length;
+    };
+
+    // Number of "{}" in pattern. Braces which are not part of a "{}" make the pattern invalid,
+    // which fails compilation as the function is consteval.
+    consteval size_t count_fields(std::string_view pattern) {
+      size_t count = 0;
+      for (size_t i = 0; i < pattern.size(); ++i) {
+        if (pattern[i] == '{') {
+          if (i + 1 == pattern.size() || pattern[i + 1] != '}') {
+            throw "Pattern contains '{' which is not followed by '}'";
+          }
+          ++count;
+          ++i;
+        } else if (pattern[i] == '}') {
+          throw "Pattern contains '}' which is not preceded by '{'";
+        }
+      }
+      return count;
+    }
+
+    // Literals before, between and after the fields
+    template <size_t NumFields>
+    consteval std::array<Segment, NumFields + 1> literal_segments(std::string_view pattern) {
+      std::array<Segment, NumFields + 1> segments{};
+      size_t index = 0;
+      size_t start = 0;
+      for (size_t i = 0; i < pattern.size(); ++i) {
+        if (pattern[i] == '{') {
+          segments[index++] = Segment{start, i - start};
+          start = i + 2;
+          ++i;
+        }
+      }
+      segments[index] = Segment{start, pattern.size() - start};
+      return segments;
+    }
+
+    // Position in the line where matching failed and what was expected there
+    struct Mismatch {
+      static constexpr size_t no_field = static_cast<size_t>(-1);
+
+      size_t position;
+      // Index of the field which could not be parsed, or no_field if literal was expected
+      size_t field;
+      std::string_view literal;
+    };
+
+    // Parses a field at position and advances position behind it. next_literal is the literal
+    // following the field, which delimits string_view fields.
+    template <typename T>
+    bool parse_field(char const*& position,
+                     char const* end,
+                     std::string_view next_literal,
+                     T& value) {
+      if constexpr (std::is_same_v<T, std::string_view>) {
+        auto const rest = std::string_view(position, end);
+        auto const length = next_literal.empty() ? rest.size() : rest.find(next_literal);
+        if (length == std::string_view::npos) {
+          return false;
+        }
+        value = rest.substr(0, length);
+        position += length;
+        return true;
+      } else if constexpr (std::is_same_v<T, char>) {
+        if (position == end) {
+          return false;
+        }
+        value = *position++;
+        return true;
+      } else {
+        static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>,
+                      "Fields must be arithmetic types, char or std::string_view");
+        auto const [last, error] = std::from_chars(position, end, value);
+        if (error != std::errc()) {
+          return false;
+        }
+        position = last;
+        return true;
+      }
+    }
+
+    template <ScanPattern Pattern, typename... Ts>
+    std::optional<Mismatch> match(std::string_view line, std::tuple<Ts...>& values) {
+      static constexpr auto pattern = Pattern.view();
+      static constexpr auto num_fields = count_fields(pattern);
+      static_assert(num_fields == sizeof...(Ts),
+                    "Number of {} in the pattern must match the number of field types");
+      static constexpr auto literals = literal_segments<num_fields>(pattern);
+
+      char const* position = line.data();
+      char const* const end = line.data() + line.size();
+      std::optional<Mismatch> mismatch;
+      auto const offset = [&line, &position] {
+        return static_cast<size_t>(position - line.data());
+      };
+      auto const literal = [](size_t index) {
+        return pattern.substr(literals[index].offset, literals[index].length);
+      };
+      auto const match_literal = [&](size_t index) {
+        if (!std::string_view(position, end).starts_with(literal(index))) {
+          mismatch = Mismatch{offset(), Mismatch::no_field, literal(index)};
+          return false;
+        }
+        position += literals[index].length;
+        return true;
+      };
+      auto const match_field = [&]<size_t I>() {
+        using T = std::tuple_element_t<I, std::tuple<Ts...>>;
+        static_assert(!std::is_same_v<T, std::string_view> || I + 1 == num_fields ||
+                          literals[I + 1].length > 0,
+                      "A std::string_view field must be followed by a literal");
+        if (!parse_field(position, end, literal(I + 1), std::get<I>(values))) {
+          mismatch = Mismatch{offset(), I, {}};
+          return false;
+        }
+        return match_literal(I + 1);
+      };
+      bool const matched = match_literal(0) && [&]<size_t... I>(std::index_sequence<I...>) {
+        return (match_field.template operator()<I>() && ...);
+      }(std::index_sequence_for<Ts...>{});
+      if (matched && position != end) {
+        mismatch = Mismatch{offset(), Mismatch::no_field, {}};
+      }
+      return mismatch;
+    }
+
+    // offset is the position of line within the scanned text
+    [[noreturn]] inline void throw_scan_error(std::string_view line,
+                                              Mismatch const& mismatch,
+                                              size_t offset) {
+      auto const expected =
+          mismatch.field != Mismatch::no_field ? fmt::format("field {}", mismatch.field)
+          : mismatch.literal.empty()           ? std::string("end of line")
+                                               : fmt::format("\"{}\"", mismatch.literal);
+      throw ScanError(fmt::format("Could not scan \"{}\" at position {}, expected {}", line,
+                                  mismatch.position, expected),
+                      offset + mismatch.position);
+    }
+
+  }  // namespace _scan_detail
+
+  template <ScanPattern Pattern, typename... Ts>
+  std::tuple<Ts...> scan(std::string_view line) {
+    std::tuple<Ts...> values;
+    if (auto const mismatch = _scan_detail::match<Pattern>(line, values)) {
+      _scan_detail::throw_scan_error(line, *mismatch, 0);
+    }
+    return values;
+  }
+
+  template <ScanPattern Pattern, typename... Ts>
+  std::optional<std::tuple<Ts...>> try_scan(std::string_view line) {
+    std::tuple<Ts...> values;
+    if (_scan_detail::match<Pattern>(line, values)) {
+      return std::nullopt;
+    }
+    return values;
+  }
+
+  template <ScanPattern Pattern, typename... Ts>
+  std::vector<std::tuple<Ts...>> scan_lines(std::string_view text) {
+    std::vector<std::tuple<Ts...>> result;
+    for (auto const line : split_view(text, '\n')) {
+      if (line.empty()) {
+        continue;
+      }
+      auto& values = result.emplace_back();
+      if (auto const mismatch = _scan_detail::match<Pattern>(line, values)) {
+        _scan_detail::throw_scan_error(line, *mismatch,
+                                       static_cast<size_t>(line.data() - text.data()));
+      }
+    }
+    return result;
+  }
+
+}  // namespace cpp_utils
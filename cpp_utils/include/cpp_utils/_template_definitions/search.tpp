@@ -1,80 +1,259 @@
 #pragma once
 
+#include <cpp_utils/instrumentation.hpp>
 #include <cpp_utils/search.hpp>
 
+#include <algorithm>
+
 namespace cpp_utils {
 
-  template <typename T, bool FindAll, bool FindAllDistinct, class Hash>
-  std::conditional_t<
-      FindAll,
-      std::conditional_t<FindAllDistinct, std::unordered_set<T, Hash>, std::vector<T>>,
-      T>
-  depthFirstSearch(T start,
-                   std::function<std::vector<T>(T)> const& visitAndGetSuccessors,
-                   std::function<bool(T)> const& isGoal) {
-    std::vector<T> stack = {start};
-    std::conditional_t<
-        FindAll, std::conditional_t<FindAllDistinct, std::unordered_set<T, Hash>, std::vector<T>>,
-        T>
-        result;
-    if constexpr (!FindAll) {
-      result = start;
-    }
+  template <typename T,
+            bool FindAll,
+            bool FindAllDistinct,
+            class Hash,
+            class Observer,
+            class Allocator>
+  SearchResult<T, FindAll, FindAllDistinct, Hash, Allocator> depthFirstSearch(
+      T start,
+      std::function<std::vector<T>(T)> const& visitAndGetSuccessors,
+      std::function<bool(T)> const& isGoal,
+      Observer&& observer,
+      Allocator const& allocator) {
+    std::vector<T, Allocator> stack({start}, allocator);
+    auto result = [&]() -> SearchResult<T, FindAll, FindAllDistinct, Hash, Allocator> {
+      if constexpr (FindAll) {
+        return SearchResult<T, FindAll, FindAllDistinct, Hash, Allocator>(allocator);
+      } else {
+        return start;
+      }
+    }();
+    CPP_UTILS_SCOPED_TIMER("search.depth_first_search");
+    observer.on_search_begin();
     while (!stack.empty()) {
       auto current = stack.back();
       stack.pop_back();
       if (isGoal(current)) {
+        observer.on_goal();
         if constexpr (FindAll) {
           if constexpr (FindAllDistinct) {
-            result.insert(current);
+            if (!result.insert(current).second) {
+              observer.on_duplicate();
+            }
           } else {
             result.push_back(current);
           }
         } else {
+          observer.on_search_end();
           return current;
         }
       }
+      CPP_UTILS_COUNT("search.expansions", 1);
+      observer.on_expansion_begin();
       for (auto const& successor : visitAndGetSuccessors(current)) {
         stack.push_back(successor);
       }
+      observer.on_expansion_end(stack.size());
     }
+    observer.on_search_end();
     return result;
   }
 
-  template <typename T, bool FindAll, bool FindAllDistinct, class Hash>
-  std::conditional_t<
-      FindAll,
-      std::conditional_t<FindAllDistinct, std::unordered_set<T, Hash>, std::vector<T>>,
-      T>
-  breadthFirstSearch(T start,
-                     std::function<std::vector<T>(T)> const& visitAndGetSuccessors,
-                     std::function<bool(T)> const& isGoal) {
-    std::vector<T> queue = {start};
-    std::conditional_t<
-        FindAll, std::conditional_t<FindAllDistinct, std::unordered_set<T, Hash>, std::vector<T>>,
-        T>
-        result;
-    if constexpr (!FindAll) {
-      result = start;
-    }
+  template <typename T,
+            bool FindAll,
+            bool FindAllDistinct,
+            class Hash,
+            class Observer,
+            class Allocator>
+  SearchResult<T, FindAll, FindAllDistinct, Hash, Allocator> breadthFirstSearch(
+      T start,
+      std::function<std::vector<T>(T)> const& visitAndGetSuccessors,
+      std::function<bool(T)> const& isGoal,
+      Observer&& observer,
+      Allocator const& allocator) {
+    std::vector<T, Allocator> queue({start}, allocator);
+    auto result = [&]() -> SearchResult<T, FindAll, FindAllDistinct, Hash, Allocator> {
+      if constexpr (FindAll) {
+        return SearchResult<T, FindAll, FindAllDistinct, Hash, Allocator>(allocator);
+      } else {
+        return start;
+      }
+    }();
+    CPP_UTILS_SCOPED_TIMER("search.breadth_first_search");
+    observer.on_search_begin();
     while (!queue.empty()) {
       auto current = queue.front();
       queue.erase(queue.begin());
       if (isGoal(current)) {
+        observer.on_goal();
         if constexpr (FindAll) {
           if constexpr (FindAllDistinct) {
-            result.insert(current);
+            if (!result.insert(current).second) {
+              observer.on_duplicate();
+            }
           } else {
             result.push_back(current);
           }
         } else {
+          observer.on_search_end();
           return current;
         }
       }
+      CPP_UTILS_COUNT("search.expansions", 1);
+      observer.on_expansion_begin();
       for (auto const& successor : visitAndGetSuccessors(current)) {
         queue.push_back(successor);
       }
+      observer.on_expansion_end(queue.size());
     }
+    observer.on_search_end();
     return result;
   }
+
+  template <typename T, bool WithDepth>
+  Generator<std::conditional_t<WithDepth, std::pair<T, size_t>, T>> lazyDepthFirstSearch(
+      T start,
+      std::function<std::vector<T>(T)> visitAndGetSuccessors,
+      std::function<bool(T)> isGoal) {
+    // Stack of (state, depth)
+    std::vector<std::pair<T, size_t>> stack = {{start, 0}};
+    while (!stack.empty()) {
+      auto [current, depth] = std::move(stack.back());
+      stack.pop_back();
+      if (isGoal(current)) {
+        if constexpr (WithDepth) {
+          co_yield std::pair<T, size_t>{current, depth};
+        } else {
+          co_yield current;
+        }
+      }
+      CPP_UTILS_COUNT("search.expansions", 1);
+      for (auto const& successor : visitAndGetSuccessors(current)) {
+        stack.emplace_back(successor, depth + 1);
+      }
+    }
+  }
+
+  template <typename T, bool WithDepth>
+  Generator<std::conditional_t<WithDepth, std::pair<T, size_t>, T>> lazyBreadthFirstSearch(
+      T start,
+      std::function<std::vector<T>(T)> visitAndGetSuccessors,
+      std::function<bool(T)> isGoal) {
+    // Queue of (state, depth)
+    std::deque<std::pair<T, size_t>> queue = {{start, 0}};
+    while (!queue.empty()) {
+      auto [current, depth] = std::move(queue.front());
+      queue.pop_front();
+      if (isGoal(current)) {
+        if constexpr (WithDepth) {
+          co_yield std::pair<T, size_t>{current, depth};
+        } else {
+          co_yield current;
+        }
+      }
+      CPP_UTILS_COUNT("search.expansions", 1);
+      for (auto const& successor : visitAndGetSuccessors(current)) {
+        queue.emplace_back(successor, depth + 1);
+      }
+    }
+  }
+
+  template <typename T, class Hash, class Observer, class Allocator>
+  std::optional<std::vector<T>> bidirectionalSearch(
+      T start,
+      T goal,
+      std::function<std::vector<T>(T)> const& getSuccessors,
+      std::function<std::vector<T>(T)> const& getPredecessors,
+      Observer&& observer,
+      Allocator const& allocator) {
+    // Breadth-first search from both start and goal. Always expands one full layer of the smaller
+    // frontier and stops as soon as the two frontiers meet.
+    //
+    // Args:
+    //   start: the start state
+    //   goal: the goal state
+    //   getSuccessors: returns the states reachable from a state in one step
+    //   getPredecessors: returns the states from which a state is reachable in one step
+    // Returns:
+    //   The states of a shortest path from start to goal (both inclusive), or std::nullopt if the
+    //   goal cannot be reached from start.
+    CPP_UTILS_SCOPED_TIMER("search.bidirectional_search");
+    observer.on_search_begin();
+    if (start == goal) {
+      observer.on_goal();
+      observer.on_search_end();
+      return std::vector<T>{start};
+    }
+
+    // Maps each visited state to its parent (towards start resp. goal) and its depth
+    using Visited = std::unordered_map<
+        T, std::pair<T, size_t>, Hash, std::equal_to<T>,
+        typename std::allocator_traits<Allocator>::template rebind_alloc<
+            std::pair<T const, std::pair<T, size_t>>>>;
+    using Frontier = std::vector<T, Allocator>;
+    Visited forward_visited(allocator);
+    Visited backward_visited(allocator);
+    forward_visited.try_emplace(start, start, 0);
+    backward_visited.try_emplace(goal, goal, 0);
+    Frontier forward_frontier({start}, allocator);
+    Frontier backward_frontier({goal}, allocator);
+
+    std::optional<T> meeting;
+    size_t best_length = 0;
+
+    auto expand_layer = [&meeting, &best_length, &observer, &allocator](
+                            Frontier& frontier, Visited& visited, Visited const& other_visited,
+                            std::function<std::vector<T>(T)> const& getNeighbors) {
+      Frontier next_frontier(allocator);
+      for (auto const& current : frontier) {
+        auto const depth = visited.at(current).second + 1;
+        CPP_UTILS_COUNT("search.expansions", 1);
+        observer.on_expansion_begin();
+        for (auto const& neighbor : getNeighbors(current)) {
+          if (!visited.try_emplace(neighbor, current, depth).second) {
+            observer.on_duplicate();
+            continue;
+          }
+          // Finish the whole layer even after a hit, a later state may give a shorter path
+          if (auto other = other_visited.find(neighbor); other != other_visited.end()) {
+            auto const length = depth + other->second.second;
+            if (!meeting.has_value() || length < best_length) {
+              meeting = neighbor;
+              best_length = length;
+            }
+          }
+          next_frontier.push_back(neighbor);
+        }
+        observer.on_expansion_end(next_frontier.size());
+      }
+      frontier = std::move(next_frontier);
+    };
+
+    while (!meeting.has_value() && !forward_frontier.empty() && !backward_frontier.empty()) {
+      if (forward_frontier.size() <= backward_frontier.size()) {
+        expand_layer(forward_frontier, forward_visited, backward_visited, getSuccessors);
+      } else {
+        expand_layer(backward_frontier, backward_visited, forward_visited, getPredecessors);
+      }
+    }
+    observer.on_search_end();
+    if (!meeting.has_value()) {
+      return std::nullopt;
+    }
+    observer.on_goal();
+
+    // Rebuild the path: meeting -> start reversed, followed by meeting -> goal
+    std::vector<T> path;
+    for (T state = *meeting;; state = forward_visited.at(state).first) {
+      path.push_back(state);
+      if (state == start) {
+        break;
+      }
+    }
+    std::ranges::reverse(path);
+    for (T state = *meeting; !(state == goal);) {
+      state = backward_visited.at(state).first;
+      path.push_back(state);
+    }
+    return path;
+  }
 }  // namespace cpp_utils
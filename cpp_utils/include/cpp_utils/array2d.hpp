@@ -10,13 +10,19 @@
 #include "coords2d.hpp"
 #include "input.hpp"
 
+#include <fmt/core.h>
+
 #include <algorithm>
 #include <cassert>
 #include <cstdint>
 #include <functional>
 #include <iterator>
+#include <memory>
+#include <memory_resource>
 #include <optional>
 #include <ranges>
+#include <span>
+#include <stdexcept>
 #include <string>
 #include <string_view>
 #include <tuple>
@@ -31,6 +37,29 @@ namespace cpp_utils {
   using Array2DDim = int64_t;
   using Array2DCoords = Coords2D<Array2DDim>;
 
+  // Bounds checking policies for element access. CheckedAccess throws std::out_of_range for
+  // invalid indices. UncheckedAccess checks the same way in debug builds, but compiles to a plain
+  // indexed load if NDEBUG is defined.
+  struct CheckedAccess {
+    static constexpr bool checked = true;
+  };
+
+  struct UncheckedAccess {
+#ifdef NDEBUG
+    static constexpr bool checked = false;
+#else
+    static constexpr bool checked = true;
+#endif
+  };
+
+  // Policy of Array2D<T> and of the row iterators, UncheckedAccess if the CMake option
+  // CPP_UTILS_UNCHECKED_ACCESS is enabled
+#if defined(CPP_UTILS_UNCHECKED_ACCESS) && CPP_UTILS_UNCHECKED_ACCESS
+  using DefaultArray2DAccess = UncheckedAccess;
+#else
+  using DefaultArray2DAccess = CheckedAccess;
+#endif
+
   // Abstract base class for 2D arrays
   template <typename T>
   class Array2DBase {
@@ -64,6 +93,25 @@ namespace cpp_utils {
       return is_valid_index(coords.row(), coords.col());
     }
 
+    // Throws std::out_of_range if row is not a valid row index
+    void check_row_index(size_t row) const {
+      if (row >= num_rows_) {
+        throw std::out_of_range(fmt::format("Row index {} out of range for array with {} rows",
+                                            static_cast<Array2DDim>(row), num_rows_));
+      }
+    }
+
+    // Throws std::out_of_range if (row, col) is not a valid index
+    void check_index(size_t row, size_t col) const {
+      if (!is_valid_index(row, col)) {
+        // Negative coordinates wrap around to huge indices, show them as signed
+        throw std::out_of_range(fmt::format("Index ({}, {}) out of range for array of size {}x{}",
+                                            static_cast<Array2DDim>(row),
+                                            static_cast<Array2DDim>(col), num_rows_,
+                                            num_columns_));
+      }
+    }
+
     Array2DCoords upper_left_corner() const { return Array2DCoords{0, 0}; }
     Array2DCoords upper_right_corner() const {
       return Array2DCoords{0, static_cast<Array2DDim>(num_columns_) - 1};
@@ -122,7 +170,8 @@ namespace cpp_utils {
     size_t num_columns_;
   };
 
-  template <typename T>
+  // Dense 2D array. Access selects whether operator() checks the indices.
+  template <typename T, class Access = DefaultArray2DAccess>
   class Array2D : public Array2DBase<T> {
     using base = Array2DBase<T>;
 
@@ -134,7 +183,7 @@ namespace cpp_utils {
 
     Array2D(std::vector<std::vector<T>> data)
         : base({data.size(), data.at(0).size()}), data_{std::move(data)} {
-      assert(std::all_of(data.begin(), data.end(),
+      assert(std::all_of(data_.begin(), data_.end(),
                          [this](auto const& row) { return row.size() == base::num_columns(); }));
     }
 
@@ -154,10 +203,16 @@ namespace cpp_utils {
     }
 
     typename base::reference operator()(size_t row, size_t col) override {
-      return data_.at(row).at(col);
+      if constexpr (Access::checked) {
+        base::check_index(row, col);
+      }
+      return data_[row][col];
     }
     typename base::const_reference operator()(size_t row, size_t col) const override {
-      return data_.at(row).at(col);
+      if constexpr (Access::checked) {
+        base::check_index(row, col);
+      }
+      return data_[row][col];
     }
 
     typename base::reference operator()(Array2DCoords coords) override {
@@ -167,34 +222,68 @@ namespace cpp_utils {
       return (*this)(coords.row(), coords.col());
     }
 
+    // Contiguous elements of a row, for scans which bypass the virtual element access
+    std::span<T> row_span(size_t row) {
+      if constexpr (Access::checked) {
+        base::check_row_index(row);
+      }
+      return data_[row];
+    }
+    std::span<T const> row_span(size_t row) const {
+      if constexpr (Access::checked) {
+        base::check_row_index(row);
+      }
+      return data_[row];
+    }
+
    private:
     std::vector<std::vector<T>> data_;
   };
 
-  template <typename T>
+  // The non-empty elements are kept in an ordered map whose nodes are allocated with Allocator,
+  // see pmr::SparseArray2D for an array backed by a std::pmr::memory_resource.
+  template <typename T, class Allocator = std::allocator<T>>
   class SparseArray2D : virtual public Array2DBase<T> {
     using base = Array2DBase<T>;
+    using map_type = Coords2DMap<
+        Array2DDim,
+        T,
+        typename std::allocator_traits<Allocator>::template rebind_alloc<
+            std::pair<Array2DCoords const, T>>>;
 
    public:
+    using allocator_type = Allocator;
+
     // Constructors
-    SparseArray2D(size_t num_rows, size_t num_columns, T empty_element)
-        : base({num_rows, num_columns}), empty_element_(empty_element) {}
+    SparseArray2D(size_t num_rows,
+                  size_t num_columns,
+                  T empty_element,
+                  Allocator const& allocator = Allocator())
+        : base({num_rows, num_columns}), data_(allocator), empty_element_(empty_element) {}
 
-    SparseArray2D(std::tuple<size_t, size_t> dimensions, T empty_element)
-        : base(dimensions), empty_element_(empty_element) {}
+    SparseArray2D(std::tuple<size_t, size_t> dimensions,
+                  T empty_element,
+                  Allocator const& allocator = Allocator())
+        : base(dimensions), data_(allocator), empty_element_(empty_element) {}
 
-    SparseArray2D(std::vector<std::vector<T>> data, T empty_element);
+    SparseArray2D(std::vector<std::vector<T>> data,
+                  T empty_element,
+                  Allocator const& allocator = Allocator());
 
     SparseArray2D(int num_rows,
                   int num_columns,
                   std::span<const T> const& values,
                   T empty_element,
-                  Direction direction = base::default_direction);
+                  Direction direction = base::default_direction,
+                  Allocator const& allocator = Allocator());
 
     SparseArray2D(std::tuple<size_t, size_t> dimensions,
                   std::span<const T> const& values,
                   T empty_element,
-                  Direction direction = base::default_direction);
+                  Direction direction = base::default_direction,
+                  Allocator const& allocator = Allocator());
+
+    allocator_type get_allocator() const { return allocator_type(data_.get_allocator()); }
 
     typename base::reference operator()(size_t row, size_t col) override;
     typename base::const_reference operator()(size_t row, size_t col) const override;
@@ -234,11 +323,16 @@ namespace cpp_utils {
         Array2DCoords const& coords) const;
 
    private:
-    Coords2DMap<Array2DDim, T> data_;
+    map_type data_;
     T empty_element_;
     std::optional<Array2DCoords> cleanup_coords_;
   };
 
+  namespace pmr {
+    template <typename T>
+    using SparseArray2D = cpp_utils::SparseArray2D<T, std::pmr::polymorphic_allocator<T>>;
+  }  // namespace pmr
+
 }  // namespace cpp_utils
 
 // Helper trait to check if a type is derived from Array2DBase
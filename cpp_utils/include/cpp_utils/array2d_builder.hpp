@@ -3,55 +3,106 @@
 #pragma once
 
 #include <cpp_utils/array2d.hpp>
+#include <cpp_utils/instrumentation.hpp>
+#include <cpp_utils/parallel.hpp>
+#include <fmt/format.h>
+
+#include <array>
+#include <cstring>
+#include <map>
+#include <stdexcept>
 
 namespace cpp_utils {
+  // Grid parsed by Array2DBuilder::create_from_char_grid
+  template <typename T>
+  struct CharGrid {
+    Array2D<T> array;
+    // Coordinates of each requested marker character in row-major order
+    std::map<char, std::vector<Array2DCoords>> markers;
+  };
+
   template <typename T>
   class Array2DBuilder {
    public:
     static T default_converter(std::string_view);
 
+    // Parses rows separated by row_separator into elements separated by column_separator (one
+    // character per element if it is empty) and converts each element with converter. Empty rows
+    // are skipped. With one character per element, '\n' between the rows and the default
+    // converter this goes through create_from_char_grid, which throws std::invalid_argument for
+    // rows of different width. Custom converters are called once per element.
     static Array2D<T> create_from_string(
         std::string_view input,
         std::string_view row_separator = "\n",
         std::string_view column_separator = " ",
         std::function<T(std::string_view)> converter = default_converter) {
-      auto const vec =
+      CPP_UTILS_SCOPED_TIMER("array2d_builder.create_from_string");
+      // Custom converters may be stateful, so they are not cached per distinct character
+      if (column_separator.empty() && row_separator == "\n" && is_default_converter(converter)) {
+        return create_from_char_grid(input, "", std::move(converter)).array;
+      }
+      auto vec =
           get_elements_from_input(std::move(input), row_separator, column_separator, converter);
       return Array2D<T>(std::move(vec));
     }
 
+    // Parses a grid with one character per cell and '\n' between the rows in a single pass. All
+    // rows must have the same width, empty lines are skipped. Each distinct character is
+    // converted only once, further occurrences are looked up in a 256-entry table; for char
+    // with the default converter the rows are copied as they are. The coordinates of the
+    // characters in markers (e.g. "SE" for start and end) are recorded on the way.
+    static CharGrid<T> create_from_char_grid(
+        std::string_view input,
+        std::string_view markers = "",
+        std::function<T(std::string_view)> converter = default_converter);
+
+    // Same as create_from_char_grid, with the rows converted in parallel on pool directly into
+    // their place in the array. Empty lines are only allowed at the end. The converter is called
+    // concurrently and must be thread-safe.
+    static CharGrid<T> create_from_char_grid_parallel(
+        std::string_view input,
+        ThreadPool& pool,
+        std::string_view markers = "",
+        std::function<T(std::string_view)> converter = default_converter);
+
     static SparseArray2D<T> create_sparse_from_string(
         std::string_view input,
         T empty_element,
         std::string_view row_separator = "\n",
         std::string_view column_separator = " ",
         std::function<T(std::string_view)> converter = default_converter) {
-      auto const vec =
+      CPP_UTILS_SCOPED_TIMER("array2d_builder.create_sparse_from_string");
+      auto vec =
           get_elements_from_input(std::move(input), row_separator, column_separator, converter);
       return SparseArray2D<T>(std::move(vec), empty_element);
     }
 
    private:
+    static bool is_default_converter(std::function<T(std::string_view)> const& converter);
+
     static std::vector<std::vector<T>> get_elements_from_input(
         std::string_view input,
         std::string_view row_separator,
         std::string_view column_separator,
         std::function<T(std::string_view)> converter) {
-      auto lines = cpp_utils::splitString(input, row_separator);
       std::vector<std::vector<T>> result;
-      std::ranges::transform(
-          lines | std::views::filter([](auto const& line) { return !line.empty(); }),
-          std::back_inserter(result), [column_separator, converter](std::string_view line) {
-            std::vector<T> row;
-            if (column_separator.empty()) {
-              std::transform(line.begin(), line.end(), std::back_inserter(row),
-                             [converter](char c) { return converter(std::string(1, c)); });
-            } else {
-              auto elements = cpp_utils::splitString(line, column_separator);
-              std::ranges::transform(elements, std::back_inserter(row), converter);
-            }
-            return row;
-          });
+      for (auto const line : split_view(input, row_separator)) {
+        if (line.empty()) {
+          continue;
+        }
+        std::vector<T> row;
+        row.reserve(result.empty() ? line.size() : result.front().size());
+        if (column_separator.empty()) {
+          std::transform(
+              line.begin(), line.end(), std::back_inserter(row),
+              [&converter](char const& c) { return converter(std::string_view(&c, 1)); });
+        } else {
+          for (auto const element : split_view(line, column_separator)) {
+            row.push_back(converter(element));
+          }
+        }
+        result.push_back(std::move(row));
+      }
       return result;
     }
   };
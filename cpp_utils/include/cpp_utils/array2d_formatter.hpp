@@ -33,12 +33,12 @@ namespace fmt {
   struct range_format_kind<cpp_utils::Array2DBase<T>, Char>
       : std::integral_constant<range_format, range_format::disabled> {};
 
-  template <typename Char, typename T>
-  struct range_format_kind<cpp_utils::Array2D<T>, Char>
+  template <typename Char, typename T, class Access>
+  struct range_format_kind<cpp_utils::Array2D<T, Access>, Char>
       : std::integral_constant<range_format, range_format::disabled> {};
 
-  template <typename Char, typename T>
-  struct range_format_kind<cpp_utils::SparseArray2D<T>, Char>
+  template <typename Char, typename T, class Allocator>
+  struct range_format_kind<cpp_utils::SparseArray2D<T, Allocator>, Char>
       : std::integral_constant<range_format, range_format::disabled> {};
 
   // Custom formatter for Array2DBase<T> and its derivatives
@@ -48,15 +48,15 @@ namespace fmt {
     constexpr auto parse(format_parse_context& ctx) -> decltype(ctx.begin()) { return ctx.begin(); }
   };
 
-  template <typename T>
-  struct formatter<cpp_utils::Array2D<T>>
-      : _array2d_formatter_detail::array2d_formatter<cpp_utils::Array2D<T>> {
+  template <typename T, class Access>
+  struct formatter<cpp_utils::Array2D<T, Access>>
+      : _array2d_formatter_detail::array2d_formatter<cpp_utils::Array2D<T, Access>> {
     constexpr auto parse(format_parse_context& ctx) -> decltype(ctx.begin()) { return ctx.begin(); }
   };
 
-  template <typename T>
-  struct formatter<cpp_utils::SparseArray2D<T>>
-      : _array2d_formatter_detail::array2d_formatter<cpp_utils::SparseArray2D<T>> {
+  template <typename T, class Allocator>
+  struct formatter<cpp_utils::SparseArray2D<T, Allocator>>
+      : _array2d_formatter_detail::array2d_formatter<cpp_utils::SparseArray2D<T, Allocator>> {
     constexpr auto parse(format_parse_context& ctx) -> decltype(ctx.begin()) { return ctx.begin(); }
   };
 
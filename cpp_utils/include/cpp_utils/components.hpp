@@ -0,0 +1,45 @@
+// Connected regions in 2D arrays: component labeling and flood fill.
+//
+// Two cells belong to the same region if they are direct (N, S, E, W) neighbours and
+// same_region(value_a, value_b) holds. same_region is expected to be an equivalence relation,
+// std::equal_to by default.
+
+#pragma once
+
+#include "array2d.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace cpp_utils {
+
+  struct ComponentInfo {
+    size_t area = 0;
+    // Number of cell edges which border another region or the outside of the array
+    size_t perimeter = 0;
+    // Bounding box, both corners inclusive
+    Array2DCoords upper_left;
+    Array2DCoords lower_right;
+  };
+
+  struct ComponentLabeling {
+    // Label of each cell, labels are numbered 0, 1, ... in row-major order of first appearance
+    Array2D<int32_t> labels;
+    // Information about each component, indexed by label
+    std::vector<ComponentInfo> components;
+  };
+
+  // Labels all regions of the array using two-pass union-find labeling
+  template <typename T, class SameRegion = std::equal_to<T>>
+  ComponentLabeling label_components(Array2DBase<T> const& array, SameRegion same_region = {});
+
+  // Returns the coordinates of all cells in the region containing start using a scanline fill
+  template <typename T, class SameRegion = std::equal_to<T>>
+  std::vector<Array2DCoords> flood_fill(Array2DBase<T> const& array,
+                                        Array2DCoords start,
+                                        SameRegion same_region = {});
+
+}  // namespace cpp_utils
+
+#include "_template_definitions/components.tpp"
@@ -5,10 +5,13 @@
 #include <cmath>
 #include <functional>
 #include <map>
+#include <memory>
+#include <memory_resource>
 #include <numeric>
 #include <stdexcept>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace cpp_utils {
@@ -94,15 +97,38 @@ namespace cpp_utils {
     }
   };
 
-  template <typename T>
-  using Coords2DUnorderedSet = std::unordered_set<Coords2D<T>, Coords2DHash<T>, Coords2DEqual<T>>;
+  template <typename T, class Allocator = std::allocator<Coords2D<T>>>
+  using Coords2DUnorderedSet =
+      std::unordered_set<Coords2D<T>, Coords2DHash<T>, Coords2DEqual<T>, Allocator>;
 
-  template <typename T, typename U>
+  template <typename T,
+            typename U,
+            class Allocator = std::allocator<std::pair<Coords2D<T> const, U>>>
   using Coords2DUnorderedMap =
-      std::unordered_map<Coords2D<T>, U, Coords2DHash<T>, Coords2DEqual<T>>;
-
-  template <typename T, typename U>
-  using Coords2DMap = std::map<Coords2D<T>, U, Coords2DCompare<T>>;
+      std::unordered_map<Coords2D<T>, U, Coords2DHash<T>, Coords2DEqual<T>, Allocator>;
+
+  template <typename T,
+            typename U,
+            class Allocator = std::allocator<std::pair<Coords2D<T> const, U>>>
+  using Coords2DMap = std::map<Coords2D<T>, U, Coords2DCompare<T>, Allocator>;
+
+  // Variants which allocate their nodes from a std::pmr::memory_resource, e.g. a
+  // std::pmr::monotonic_buffer_resource per puzzle run which frees all nodes at once
+  namespace pmr {
+    template <typename T>
+    using Coords2DUnorderedSet =
+        cpp_utils::Coords2DUnorderedSet<T, std::pmr::polymorphic_allocator<Coords2D<T>>>;
+
+    template <typename T, typename U>
+    using Coords2DUnorderedMap = cpp_utils::Coords2DUnorderedMap<
+        T,
+        U,
+        std::pmr::polymorphic_allocator<std::pair<Coords2D<T> const, U>>>;
+
+    template <typename T, typename U>
+    using Coords2DMap = cpp_utils::
+        Coords2DMap<T, U, std::pmr::polymorphic_allocator<std::pair<Coords2D<T> const, U>>>;
+  }  // namespace pmr
 
   template <typename T>
   cpp_utils::Coords2D<T> step_into_direction(const cpp_utils::Coords2D<T> start_coord,
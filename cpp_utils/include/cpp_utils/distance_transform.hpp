@@ -0,0 +1,39 @@
+// Distance transforms of 2D arrays: distance from every cell to the nearest source cell.
+//
+// All metrics are computed in time linear in the number of cells by scanning the array row by
+// row, a multi-source breadth-first search is not needed.
+
+#pragma once
+
+#include "array2d.hpp"
+
+#include <cstdint>
+#include <limits>
+
+namespace cpp_utils {
+
+  enum class DistanceMetric {
+    // |dr| + |dc|, steps to the direct (N, S, E, W) neighbours
+    Manhattan,
+    // max(|dr|, |dc|), steps to all eight neighbours
+    Chebyshev,
+    // dr^2 + dc^2, the exact squared Euclidean distance
+    SquaredEuclidean,
+  };
+
+  // Distance of the cells which cannot reach any source, i.e. of all cells if there is none
+  inline constexpr int32_t unreachable_distance = std::numeric_limits<int32_t>::max();
+
+  // Returns the distance from each cell to the nearest cell whose value satisfies is_source.
+  // Manhattan and Chebyshev use a forward and a backward raster scan, SquaredEuclidean the
+  // separable algorithm of Felzenszwalb and Huttenlocher (column distances in a forward and a
+  // backward scan, then the lower envelope of parabolas along each row). Throws
+  // std::out_of_range if the squared diagonal of the array does not fit into int32_t.
+  template <typename T, class IsSource>
+  Array2D<int32_t> distance_transform(Array2DBase<T> const& array,
+                                      IsSource is_source,
+                                      DistanceMetric metric = DistanceMetric::Manhattan);
+
+}  // namespace cpp_utils
+
+#include "_template_definitions/distance_transform.tpp"
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <stdexcept>
 #include <string>
 
@@ -18,4 +19,17 @@ namespace cpp_utils {
         : NotImplementedError(
               "Combination of diagonal direction and flatten not yet implemented.") {}
   };
+
+  // Input which does not match the pattern given to scan, position is the offset of the first
+  // character which could not be matched
+  class ScanError : public std::invalid_argument {
+   public:
+    ScanError(std::string const& message, size_t position)
+        : std::invalid_argument(message), position_(position) {}
+
+    size_t position() const { return position_; }
+
+   private:
+    size_t position_;
+  };
 }  // namespace cpp_utils
@@ -0,0 +1,47 @@
+// Search for the next matching cell along a straight line of a 2D array.
+//
+// The search starts at the cell after coords in direction and ends at the border of the array.
+// Dense arrays are scanned directly in their rows: along rows (East, West) with memchr/memrchr
+// for byte-sized elements and a contiguous loop otherwise, along columns (South, North) in
+// branch-free blocks of rows. Diagonals and other arrays go through the iterators of
+// Array2DBase.
+
+#pragma once
+
+#include "array2d.hpp"
+
+#include <concepts>
+#include <optional>
+#include <type_traits>
+
+namespace cpp_utils {
+
+  template <typename T, class Access, class Predicate>
+    requires std::predicate<Predicate const&, T const&>
+  std::optional<Array2DCoords> find_next(Array2D<T, Access> const& array,
+                                         Array2DCoords coords,
+                                         Direction direction,
+                                         Predicate const& predicate);
+
+  template <typename T, class Access>
+  std::optional<Array2DCoords> find_next(Array2D<T, Access> const& array,
+                                         Array2DCoords coords,
+                                         Direction direction,
+                                         std::type_identity_t<T> const& value);
+
+  template <typename T, class Predicate>
+    requires std::predicate<Predicate const&, T const&>
+  std::optional<Array2DCoords> find_next(Array2DBase<T> const& array,
+                                         Array2DCoords coords,
+                                         Direction direction,
+                                         Predicate const& predicate);
+
+  template <typename T>
+  std::optional<Array2DCoords> find_next(Array2DBase<T> const& array,
+                                         Array2DCoords coords,
+                                         Direction direction,
+                                         std::type_identity_t<T> const& value);
+
+}  // namespace cpp_utils
+
+#include "_template_definitions/find_next.tpp"
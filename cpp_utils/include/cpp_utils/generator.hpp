@@ -0,0 +1,107 @@
+// Minimal coroutine based generator, modelled after C++23 std::generator.
+//
+// A function returning Generator<T> may co_yield values of type T. The values are produced lazily
+// while iterating over the generator, destroying the generator stops the coroutine.
+
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <optional>
+#include <utility>
+
+namespace cpp_utils {
+
+  template <typename T>
+  class Generator {
+   public:
+    struct promise_type {
+      std::optional<T> value_;
+      std::exception_ptr exception_;
+
+      Generator get_return_object() {
+        return Generator{std::coroutine_handle<promise_type>::from_promise(*this)};
+      }
+      std::suspend_always initial_suspend() noexcept { return {}; }
+      std::suspend_always final_suspend() noexcept { return {}; }
+      std::suspend_always yield_value(T value) {
+        value_ = std::move(value);
+        return {};
+      }
+      void return_void() {}
+      void unhandled_exception() { exception_ = std::current_exception(); }
+
+      // Generators only yield, they cannot await anything
+      template <typename U>
+      std::suspend_never await_transform(U&&) = delete;
+    };
+
+    using handle_type = std::coroutine_handle<promise_type>;
+
+    class Iterator {
+     public:
+      using iterator_category = std::input_iterator_tag;
+      using value_type = T;
+      using difference_type = std::ptrdiff_t;
+
+      Iterator() = default;
+      explicit Iterator(handle_type handle) : handle_(handle) {}
+
+      T const& operator*() const { return *handle_.promise().value_; }
+      T const* operator->() const { return &*handle_.promise().value_; }
+
+      Iterator& operator++() {
+        resume(handle_);
+        return *this;
+      }
+      void operator++(int) { ++(*this); }
+
+      bool operator==(std::default_sentinel_t) const { return !handle_ || handle_.done(); }
+
+     private:
+      handle_type handle_;
+    };
+
+    Generator(Generator const&) = delete;
+    Generator(Generator&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+    ~Generator() {
+      if (handle_) {
+        handle_.destroy();
+      }
+    }
+
+    Generator& operator=(Generator const&) = delete;
+    Generator& operator=(Generator&& other) noexcept {
+      if (this != &other) {
+        if (handle_) {
+          handle_.destroy();
+        }
+        handle_ = std::exchange(other.handle_, {});
+      }
+      return *this;
+    }
+
+    // Starts the coroutine, may only be called once
+    Iterator begin() {
+      resume(handle_);
+      return Iterator{handle_};
+    }
+    std::default_sentinel_t end() const { return {}; }
+
+   private:
+    explicit Generator(handle_type handle) : handle_(handle) {}
+
+    static void resume(handle_type handle) {
+      handle.promise().value_.reset();
+      handle.resume();
+      if (handle.promise().exception_) {
+        std::rethrow_exception(std::exchange(handle.promise().exception_, {}));
+      }
+    }
+
+    handle_type handle_;
+  };
+
+}  // namespace cpp_utils
@@ -0,0 +1,65 @@
+// Contraction of maze-like 2D arrays into weighted graphs.
+//
+// Open cells with exactly two open direct neighbours are corridor cells. All other open cells
+// (junctions and dead ends) and any explicitly requested cells become nodes, the corridors between
+// them become edges weighted by their length.
+
+#pragma once
+
+#include "array2d.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace cpp_utils {
+
+  struct GridGraphEdge {
+    size_t target;
+    int64_t length;
+  };
+
+  class GridGraph {
+   public:
+    GridGraph(std::tuple<size_t, size_t> dimensions,
+              std::vector<Array2DCoords> nodes,
+              std::vector<std::vector<GridGraphEdge>> const& adjacency);
+
+    size_t num_nodes() const { return nodes_.size(); }
+
+    Array2DCoords const& coords(size_t node) const { return nodes_.at(node); }
+
+    // Returns the index of the node at coords or std::nullopt if coords is not a node
+    std::optional<size_t> node_index(Array2DCoords coords) const;
+
+    std::span<GridGraphEdge const> edges(size_t node) const {
+      return std::span<GridGraphEdge const>(edges_.data() + edge_offsets_.at(node),
+                                            edges_.data() + edge_offsets_.at(node + 1));
+    }
+
+   private:
+    size_t num_columns_;
+    std::vector<Array2DCoords> nodes_;
+    // Index of the node at each cell (row-major) or -1
+    std::vector<int32_t> node_at_cell_;
+    // Adjacency array: the edges of node i are edges_[edge_offsets_[i]:edge_offsets_[i + 1]]
+    std::vector<size_t> edge_offsets_;
+    std::vector<GridGraphEdge> edges_;
+  };
+
+  template <typename T, class IsOpen>
+  GridGraph contract_grid(Array2DBase<T> const& array,
+                          IsOpen is_open,
+                          std::vector<Array2DCoords> const& extra_nodes = {});
+
+  // Dijkstra, returns the distance from source to each node (INT64_MAX if unreachable)
+  std::vector<int64_t> shortest_distances(GridGraph const& graph, size_t source);
+
+  // Length of the longest path from source to target which visits no node twice, or
+  // std::nullopt if target is unreachable. Exhaustive search, the graph must have at most 64 nodes.
+  std::optional<int64_t> longest_simple_path(GridGraph const& graph, size_t source, size_t target);
+
+}  // namespace cpp_utils
+
+#include "_template_definitions/grid_graph.tpp"
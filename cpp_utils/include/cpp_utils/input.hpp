@@ -2,19 +2,253 @@
 
 #include <fmt/core.h>
 
+#include <cstddef>
+#include <cstring>
 #include <fstream>
+#include <iterator>
 #include <optional>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 namespace cpp_utils {
 
+  // Read-only view of a whole input file which owns the underlying memory.
+  //
+  // The file is memory-mapped, so no copy is made. If it cannot be mapped (e.g. a pipe or stdin,
+  // given as "-"), it is read into a single cache-line aligned buffer instead. Converts implicitly
+  // to std::string_view, so it can be passed to splitString, Array2DBuilder and the other parsers
+  // directly.
+  class InputBuffer {
+   public:
+    explicit InputBuffer(std::string const& filename);
+    ~InputBuffer();
+
+    InputBuffer(InputBuffer const&) = delete;
+    InputBuffer(InputBuffer&& other) noexcept;
+    InputBuffer& operator=(InputBuffer const&) = delete;
+    InputBuffer& operator=(InputBuffer&& other) noexcept;
+
+    std::string_view view() const { return std::string_view(data_, size_); }
+    operator std::string_view() const { return view(); }
+
+    size_t size() const { return size_; }
+    bool is_memory_mapped() const { return mapped_; }
+
+   private:
+    void release();
+    void read_from(int fd, size_t size_hint);
+
+    char* data_ = nullptr;
+    size_t size_ = 0;
+    // True if data_ is a mapping, otherwise it is owned and released with free
+    bool mapped_ = false;
+  };
+
+  InputBuffer readInputBufferGivenByArgument(int argc, char* argv[]);
+
+  // Reads a file line by line through a reusable buffer of bounded size, so inputs larger than
+  // memory can be processed in constant memory. A line is only valid until the next line is
+  // read. The buffer grows only if a single line does not fit. Lines are returned without the
+  // '\n', empty lines are kept but no empty line follows a trailing '\n'. "-" reads stdin.
+  class LineReader {
+   public:
+    class Iterator {
+     public:
+      using iterator_category = std::input_iterator_tag;
+      using value_type = std::string_view;
+      using difference_type = std::ptrdiff_t;
+
+      Iterator() = default;
+
+      std::string_view operator*() const { return *line_; }
+
+      Iterator& operator++() {
+        line_ = reader_->next_line();
+        return *this;
+      }
+      void operator++(int) { ++*this; }
+
+      bool operator==(std::default_sentinel_t) const { return !line_; }
+
+     private:
+      friend class LineReader;
+
+      explicit Iterator(LineReader* reader) : reader_(reader), line_(reader->next_line()) {}
+
+      LineReader* reader_ = nullptr;
+      std::optional<std::string_view> line_;
+    };
+
+    explicit LineReader(std::string const& filename, size_t buffer_size = 1 << 16);
+    ~LineReader();
+
+    LineReader(LineReader const&) = delete;
+    LineReader(LineReader&& other) noexcept;
+    LineReader& operator=(LineReader const&) = delete;
+    LineReader& operator=(LineReader&& other) noexcept;
+
+    // Next line or std::nullopt at the end of the input
+    std::optional<std::string_view> next_line();
+
+    // Single pass over the remaining lines
+    Iterator begin() { return Iterator(this); }
+    std::default_sentinel_t end() const { return {}; }
+
+   private:
+    // Reads more data behind the unconsumed part of the buffer, false at the end of the input
+    bool fill();
+    void close();
+
+    int fd_ = -1;
+    // stdin is not closed
+    bool owns_fd_ = false;
+    std::vector<char> buffer_;
+    // Unconsumed data is buffer_[begin_, end_), the part before scanned_ contains no '\n'
+    size_t begin_ = 0;
+    size_t scanned_ = 0;
+    size_t end_ = 0;
+    bool eof_ = false;
+  };
+
+  LineReader readLinesGivenByArgument(int argc, char* argv[]);
+
   std::string readInputFileGivenByName(std::string const& filename);
 
   std::string readInputFileGivenByArgument(int argc, char* argv[]);
 
+  // Lazy view over the fields of str separated by delimiter. Empty fields are skipped, except for
+  // the last field which is always produced (same semantics as splitString). Single byte
+  // delimiters are searched with memchr, longer ones with memmem (two-way search) if glibc
+  // provides it and with std::string_view::find otherwise. The view refers to str and to
+  // delimiters longer than one byte, both must outlive it.
+  class SplitView {
+   public:
+    class Iterator {
+     public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = std::string_view;
+      using difference_type = std::ptrdiff_t;
+
+      Iterator() = default;
+
+      std::string_view operator*() const { return current_; }
+      std::string_view const* operator->() const { return &current_; }
+
+      Iterator& operator++() {
+        advance();
+        return *this;
+      }
+      Iterator operator++(int) {
+        Iterator tmp = *this;
+        advance();
+        return tmp;
+      }
+
+      bool operator==(Iterator const& other) const {
+        return done_ == other.done_ && (done_ || current_.data() == other.current_.data());
+      }
+      bool operator==(std::default_sentinel_t) const { return done_; }
+
+     private:
+      friend class SplitView;
+
+      Iterator(std::string_view str,
+               std::string_view delimiter,
+               char single_delimiter,
+               size_t delimiter_size)
+          : str_(str),
+            delimiter_(delimiter),
+            single_delimiter_(single_delimiter),
+            delimiter_size_(delimiter_size),
+            done_(false) {
+        advance();
+      }
+
+      size_t find_delimiter(size_t from) const {
+        if (from >= str_.size()) {
+          return std::string_view::npos;
+        }
+        if (delimiter_size_ == 1) {
+          auto const* found = static_cast<char const*>(
+              std::memchr(str_.data() + from, single_delimiter_, str_.size() - from));
+          return found == nullptr ? std::string_view::npos : found - str_.data();
+        }
+#ifdef __GLIBC__
+        auto const* found = static_cast<char const*>(::memmem(
+            str_.data() + from, str_.size() - from, delimiter_.data(), delimiter_.size()));
+        return found == nullptr ? std::string_view::npos : found - str_.data();
+#else
+        // memmem is a GNU extension
+        return str_.find(delimiter_, from);
+#endif
+      }
+
+      void advance() {
+        if (last_field_produced_) {
+          done_ = true;
+          return;
+        }
+        while (true) {
+          auto const end = find_delimiter(position_);
+          if (end == std::string_view::npos) {
+            current_ = str_.substr(position_);
+            last_field_produced_ = true;
+            return;
+          }
+          auto const start = std::exchange(position_, end + delimiter_size_);
+          if (end > start) {
+            current_ = str_.substr(start, end - start);
+            return;
+          }
+        }
+      }
+
+      std::string_view str_;
+      std::string_view delimiter_;
+      char single_delimiter_ = 0;
+      size_t delimiter_size_ = 0;
+      size_t position_ = 0;
+      std::string_view current_;
+      bool last_field_produced_ = false;
+      bool done_ = true;
+    };
+
+    SplitView(std::string_view str, std::string_view delimiter)
+        : str_(str), delimiter_(delimiter), delimiter_size_(delimiter.size()) {
+      if (delimiter.empty()) {
+        throw std::invalid_argument("Delimiter must not be empty");
+      }
+      single_delimiter_ = delimiter.front();
+    }
+
+    SplitView(std::string_view str, char delimiter)
+        : str_(str), single_delimiter_(delimiter), delimiter_size_(1) {}
+
+    Iterator begin() const {
+      return Iterator(str_, delimiter_, single_delimiter_, delimiter_size_);
+    }
+    std::default_sentinel_t end() const { return {}; }
+
+   private:
+    std::string_view str_;
+    // Only used for delimiters longer than one byte, single bytes are copied
+    std::string_view delimiter_;
+    char single_delimiter_ = 0;
+    size_t delimiter_size_;
+  };
+
+  inline SplitView split_view(std::string_view str, std::string_view delimiter) {
+    return SplitView(str, delimiter);
+  }
+
+  inline SplitView split_view(std::string_view str, char delimiter) {
+    return SplitView(str, delimiter);
+  }
+
   std::vector<std::string_view> splitString(std::string_view const& str,
                                             std::string_view const& delimiter);
 
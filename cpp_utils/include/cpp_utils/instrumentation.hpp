@@ -0,0 +1,167 @@
+// Scoped timers, counters and histograms for finding out where a run spends its time.
+//
+// The macros below are compiled out completely unless the CMake option CPP_UTILS_INSTRUMENTATION
+// is enabled, which defines CPP_UTILS_INSTRUMENTATION=1:
+//
+//   CPP_UTILS_SCOPED_TIMER("parse");           // times the enclosing scope
+//   CPP_UTILS_COUNT("search.expansions", 1);   // adds to a monotonic counter
+//   CPP_UTILS_HISTOGRAM("merge.size", n);      // records a value in power-of-two buckets
+//
+// Each call site looks up its statistic once, later updates are relaxed atomic additions. At
+// exit a summary table is printed to stderr. Setting $CPP_UTILS_TRACE_FILE additionally records
+// every timed scope and writes them to that file as Chrome trace events (viewable in
+// chrome://tracing or Perfetto). Trace events are buffered per thread and handed to the registry
+// in batches, so timed scopes do not contend on a lock.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cpp_utils::instrumentation {
+
+  using Clock = std::chrono::steady_clock;
+
+  struct TimerStatistic {
+    std::string name;
+    std::atomic<uint64_t> calls = 0;
+    std::atomic<uint64_t> total_ns = 0;
+    std::atomic<uint64_t> max_ns = 0;
+  };
+
+  struct CounterStatistic {
+    std::string name;
+    std::atomic<uint64_t> value = 0;
+
+    void add(uint64_t amount) { value.fetch_add(amount, std::memory_order_relaxed); }
+  };
+
+  struct HistogramStatistic {
+    // Bucket i counts values in [2^(i-1), 2^i) (bucket 0: value 0)
+    static constexpr size_t num_buckets = 65;
+
+    std::string name;
+    std::atomic<uint64_t> count = 0;
+    std::atomic<uint64_t> sum = 0;
+    std::atomic<uint64_t> max = 0;
+    std::array<std::atomic<uint64_t>, num_buckets> buckets{};
+
+    void record(uint64_t value);
+  };
+
+  class ThreadTraceBuffer;
+
+  // Owner of all statistics and of the recorded trace events
+  class Registry {
+   public:
+    static Registry& instance();
+
+    // Statistics are created on first use and live as long as the registry
+    TimerStatistic& timer(std::string_view name);
+    CounterStatistic& counter(std::string_view name);
+    HistogramStatistic& histogram(std::string_view name);
+
+    void record(TimerStatistic& timer, Clock::time_point start, Clock::time_point end);
+
+    // Trace events are only recorded while tracing is enabled, initially iff
+    // $CPP_UTILS_TRACE_FILE is set
+    void set_tracing(bool enabled) { tracing_.store(enabled, std::memory_order_relaxed); }
+    bool tracing() const { return tracing_.load(std::memory_order_relaxed); }
+
+    std::string summary() const;
+
+    // Contains the events flushed by other threads (in batches and at thread exit) and all events
+    // of the calling thread
+    std::string chrome_trace() const;
+
+    // Resets all statistics to zero and drops the trace events
+    void reset();
+
+    // Prints the summary and writes the trace if anything was recorded since the last reset
+    ~Registry();
+
+   private:
+    friend class ThreadTraceBuffer;
+
+    Registry();
+
+    struct TraceEvent {
+      TimerStatistic const* timer;
+      uint32_t thread;
+      Clock::time_point start;
+      Clock::time_point end;
+    };
+
+    // Bounds the memory used for the trace, later events only count in the summary
+    static constexpr size_t max_trace_events = size_t{1} << 20;
+
+    void append_trace_events(std::vector<TraceEvent> const& events);
+    std::string chrome_trace(std::vector<TraceEvent> const& pending) const;
+
+    Clock::time_point const created_ = Clock::now();
+    mutable std::mutex mutex_;
+    std::map<std::string, std::unique_ptr<TimerStatistic>, std::less<>> timers_;
+    std::map<std::string, std::unique_ptr<CounterStatistic>, std::less<>> counters_;
+    std::map<std::string, std::unique_ptr<HistogramStatistic>, std::less<>> histograms_;
+    std::vector<TraceEvent> trace_events_;
+    size_t dropped_trace_events_ = 0;
+    std::atomic<bool> tracing_ = false;
+  };
+
+  class ScopedTimer {
+   public:
+    explicit ScopedTimer(TimerStatistic& timer) : timer_(timer), start_(Clock::now()) {}
+    ~ScopedTimer() { Registry::instance().record(timer_, start_, Clock::now()); }
+
+    ScopedTimer(ScopedTimer const&) = delete;
+    ScopedTimer& operator=(ScopedTimer const&) = delete;
+
+   private:
+    TimerStatistic& timer_;
+    Clock::time_point start_;
+  };
+
+}  // namespace cpp_utils::instrumentation
+
+#define CPP_UTILS_INSTRUMENTATION_CONCAT_IMPL(a, b) a##b
+#define CPP_UTILS_INSTRUMENTATION_CONCAT(a, b) CPP_UTILS_INSTRUMENTATION_CONCAT_IMPL(a, b)
+
+#if defined(CPP_UTILS_INSTRUMENTATION) && CPP_UTILS_INSTRUMENTATION
+
+#define CPP_UTILS_SCOPED_TIMER(name)                                                          \
+  static auto& CPP_UTILS_INSTRUMENTATION_CONCAT(cpp_utils_timer_, __LINE__) =                 \
+      ::cpp_utils::instrumentation::Registry::instance().timer(name);                         \
+  ::cpp_utils::instrumentation::ScopedTimer CPP_UTILS_INSTRUMENTATION_CONCAT(                 \
+      cpp_utils_scoped_timer_, __LINE__)(CPP_UTILS_INSTRUMENTATION_CONCAT(cpp_utils_timer_, \
+                                                                          __LINE__))
+
+#define CPP_UTILS_COUNT(name, amount)                                                       \
+  do {                                                                                      \
+    static auto& cpp_utils_counter =                                                        \
+        ::cpp_utils::instrumentation::Registry::instance().counter(name);                   \
+    cpp_utils_counter.add(static_cast<uint64_t>(amount));                                   \
+  } while (false)
+
+#define CPP_UTILS_HISTOGRAM(name, value)                                                    \
+  do {                                                                                      \
+    static auto& cpp_utils_histogram =                                                      \
+        ::cpp_utils::instrumentation::Registry::instance().histogram(name);                 \
+    cpp_utils_histogram.record(static_cast<uint64_t>(value));                               \
+  } while (false)
+
+#else
+
+#define CPP_UTILS_SCOPED_TIMER(name) static_cast<void>(0)
+#define CPP_UTILS_COUNT(name, amount) static_cast<void>(0)
+#define CPP_UTILS_HISTOGRAM(name, value) static_cast<void>(0)
+
+#endif
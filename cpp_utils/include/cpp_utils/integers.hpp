@@ -0,0 +1,32 @@
+// Extraction of all integers contained in input text.
+//
+// An integer is a run of decimal digits, for signed types optionally preceded by '-' (like the
+// regular expression -?[0-9]+). Everything else is treated as separator, e.g.
+// "p=0,4 v=3,-3" contains the integers 0, 4, 3 and -3.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace cpp_utils {
+
+  template <typename T = int64_t>
+  std::vector<T> extract_integers(std::string_view text);
+
+  // Writes the integers of text into out, returns the number of integers written. Throws
+  // std::length_error if text contains more integers than out can hold.
+  template <typename T>
+  size_t extract_integers(std::string_view text, std::span<T> out);
+
+  // Integers of each line of text. Empty lines give empty vectors, the empty line after a
+  // trailing newline is left out.
+  template <typename T = int64_t>
+  std::vector<std::vector<T>> extract_integers_per_line(std::string_view text);
+
+}  // namespace cpp_utils
+
+#include "_template_definitions/integers.tpp"
@@ -0,0 +1,68 @@
+// Piecewise offset mapping of ordered (discrete) type T.
+//
+// Each rule maps the closed source interval [first, second] to [first + offset, second + offset].
+// Values which are not covered by any rule are mapped to themselves.
+
+#pragma once
+
+#include "intervals.hpp"
+
+#include <utility>
+#include <vector>
+
+namespace cpp_utils {
+
+  template <typename T>
+  class IntervalMap {
+   public:
+    using Interval = typename Intervals<T>::Interval;
+
+    struct Rule {
+      Interval source;
+      T offset;
+
+      bool operator==(Rule const& other) const = default;
+    };
+
+    IntervalMap() = default;
+    // The source intervals of the rules must not overlap
+    IntervalMap(std::vector<Rule> rules);
+
+    // Inserts a single rule in O(log n + n), rules touching it with the same offset are merged
+    void insert_rule(Interval source, T offset);
+
+    // Inserts many rules at once with a single sort
+    void insert_rules(std::vector<Rule> const& rules);
+
+    // Maps a single value
+    T operator()(T value) const;
+
+    // Maps all values of intervals by splitting and shifting whole ranges in a single merge pass
+    // over the intervals and the rules.
+    Intervals<T> transform(Intervals<T> const& intervals) const;
+
+    // Returns the map which is equivalent to applying this map and then next
+    IntervalMap then(IntervalMap const& next) const;
+
+    // Rules sorted by their source interval
+    std::vector<Rule> const& rules() const { return rules_; }
+
+   private:
+    using RuleIterator = typename std::vector<Rule>::const_iterator;
+
+    // Sorts the rules, checks that they do not overlap and merges touching rules with the same
+    // offset
+    void normalize();
+
+    // Splits [start, end] into maximal pieces with the same offset and calls
+    // f(piece_start, piece_end, offset) for each of them in ascending order. rule must not point
+    // behind the first rule overlapping [start, end] and is advanced.
+    template <class F>
+    void for_each_piece(T start, T end, RuleIterator& rule, F&& f) const;
+
+    std::vector<Rule> rules_;
+  };
+
+}  // namespace cpp_utils
+
+#include "_template_definitions/interval_map.tpp"
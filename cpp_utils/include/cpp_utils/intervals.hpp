@@ -2,35 +2,90 @@
 
 #pragma once
 
-#include <map>
+#include <cstddef>
+#include <span>
+#include <utility>
 #include <vector>
 
 namespace cpp_utils {
 
   template <typename T>
   class Intervals {
+   public:
+    // Closed interval [first, second]
     using Interval = std::pair<T, T>;
 
-   public:
     Intervals() = default;
     ~Intervals() = default;
     Intervals(Intervals const&) = default;
     Intervals(Intervals&&) = default;
+    // Sorts the intervals once and merges them in a single sweep
     Intervals(std::vector<Interval> intervals);
 
     void insert_interval(Interval interval);
     void insert_interval(T start, T end);
 
+    // Buffers the interval, it is merged into the set before the next query. Use this when
+    // inserting many intervals at once. The first query after deferred inserts merges them even
+    // if it is const, so const queries are only safe to run concurrently after flush().
+    void insert_interval_deferred(T start, T end);
+
+    // Merges all deferred intervals
+    void flush() { merge_pending(); }
+
     bool contains(T value) const;
 
+    // Batch membership queries. Sorted values are answered in one linear merge walk, unsorted
+    // ones by a branchless binary search over contiguous copies of the interval bounds.
+    std::vector<bool> contains(std::span<T const> values) const;
+    size_t count_contained(std::span<T const> values) const;
+
     T total_area() const;
 
+    // The disjoint intervals sorted by their start
+    std::vector<Interval> const& intervals() const {
+      merge_pending();
+      return intervals_;
+    }
+
+    // Set algebra. Each operation is a single linear merge of the two sorted interval lists.
+    // Difference and complement assume a discrete T, i.e. that value + 1 is the next value.
+    Intervals operator|(Intervals const& other) const;
+    Intervals operator&(Intervals const& other) const;
+    Intervals operator-(Intervals const& other) const;
+
+    // In-place variants, they reuse the storage of this set where possible
+    Intervals& operator|=(Intervals const& other);
+    Intervals& operator&=(Intervals const& other);
+    Intervals& operator-=(Intervals const& other);
+
+    // Values in [lower, upper] which are not contained in any interval
+    Intervals complement(T lower, T upper) const;
+
+    bool operator==(Intervals const& other) const { return intervals() == other.intervals(); }
+
     Intervals& operator=(Intervals const&) = default;
     Intervals& operator=(Intervals&&) = default;
 
    private:
-    // Maps start (inclusive) -> end (inclusive)
-    std::map<T, T> intervals_;
+    // Takes over intervals which are already sorted, disjoint and valid
+    static Intervals from_sorted(std::vector<Interval> intervals);
+
+    // Calls f(index, is_contained) for each value
+    template <class F>
+    void for_each_membership(std::span<T const> values, F&& f) const;
+
+    // Merges the deferred intervals into intervals_
+    void merge_pending() const;
+
+    // Sorts intervals and merges overlapping ones in place
+    static void sort_and_merge(std::vector<Interval>& intervals);
+
+    // Disjoint intervals sorted by their start (both inclusive). The storage is contiguous, so a
+    // lookup is a binary search over a flat array.
+    mutable std::vector<Interval> intervals_;
+    // Deferred intervals, not yet merged into intervals_
+    mutable std::vector<Interval> pending_;
   };
 
 }  // namespace cpp_utils
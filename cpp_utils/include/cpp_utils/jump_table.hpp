@@ -0,0 +1,65 @@
+// Jump tables for "move until the next obstacle" queries on dense 2D arrays.
+//
+// For each cell and each of the eight directions the table stores the next obstacle along that
+// direction, so a slide (guard patrols, tilting rocks, sliding on ice) is a single lookup instead
+// of a walk through the array.
+
+#pragma once
+
+#include "array2d.hpp"
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+namespace cpp_utils {
+
+  class JumpTable2D {
+   public:
+    // Table for the given obstacles in row-major order, non-zero entries are obstacles
+    JumpTable2D(std::tuple<size_t, size_t> dimensions, std::vector<uint8_t> obstacles);
+
+    // Table for the cells of array whose value satisfies is_obstacle
+    template <typename T, class IsObstacle>
+    JumpTable2D(Array2DBase<T> const& array, IsObstacle is_obstacle);
+
+    size_t num_rows() const { return num_rows_; }
+    size_t num_columns() const { return num_columns_; }
+
+    bool is_obstacle(Array2DCoords coords) const { return obstacles_[index(coords)] != 0; }
+
+    // First obstacle strictly after coords in direction, or std::nullopt if the border of the
+    // array is reached first. O(1).
+    std::optional<Array2DCoords> next_obstacle(Array2DCoords coords, Direction direction) const;
+
+    // Last cell before the next obstacle in direction, or the last cell before the border if there
+    // is none. Returns coords itself if the neighbouring cell is blocked. O(1).
+    Array2DCoords slide(Array2DCoords coords, Direction direction) const;
+
+    // Adds or removes the obstacle at coords. Only the cells on the eight rays leaving coords up
+    // to the next obstacle are updated, i.e. O(num_rows + num_columns) work.
+    void set_obstacle(Array2DCoords coords, bool obstacle);
+
+   private:
+    // Throws std::out_of_range for coordinates outside of the table
+    size_t index(Array2DCoords coords) const;
+
+    Array2DCoords coords_of(int32_t index) const {
+      return Array2DCoords{index / static_cast<Array2DDim>(num_columns_),
+                           index % static_cast<Array2DDim>(num_columns_)};
+    }
+
+    void build(Direction direction);
+
+    size_t num_rows_;
+    size_t num_columns_;
+    std::vector<uint8_t> obstacles_;
+    // Row-major index of the next obstacle of each cell (or -1) per direction
+    std::array<std::vector<int32_t>, 8> next_;
+  };
+
+}  // namespace cpp_utils
+
+#include "_template_definitions/jump_table.tpp"
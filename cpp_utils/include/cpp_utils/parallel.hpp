@@ -0,0 +1,77 @@
+// Parallel parsing of large inputs.
+//
+// The input is split at line boundaries into roughly equal chunks which are parsed on the
+// workers of a ThreadPool. Results are returned in input order, so parsing in parallel gives the
+// same result as parsing sequentially.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace cpp_utils {
+
+  // Fixed set of worker threads which run batches of indexed tasks
+  class ThreadPool {
+   public:
+    explicit ThreadPool(size_t num_threads = std::thread::hardware_concurrency());
+    ~ThreadPool();
+
+    ThreadPool(ThreadPool const&) = delete;
+    ThreadPool& operator=(ThreadPool const&) = delete;
+
+    size_t num_threads() const { return workers_.size(); }
+
+    // Calls task(i) for each i in [0, num_tasks) on the workers and waits until all calls have
+    // finished. The first exception thrown by a task is rethrown here, remaining tasks are
+    // skipped. Batches from different threads are run one after another. A task which calls run
+    // on its own pool gets its nested batch run inline on the calling worker instead of
+    // deadlocking.
+    void run(size_t num_tasks, std::function<void(size_t)> const& task);
+
+   private:
+    void work();
+
+    std::vector<std::thread> workers_;
+    std::mutex run_mutex_;
+    std::mutex mutex_;
+    std::condition_variable batch_started_;
+    std::condition_variable batch_finished_;
+    std::function<void(size_t)> const* task_ = nullptr;
+    size_t num_tasks_ = 0;
+    size_t next_task_ = 0;
+    size_t unfinished_tasks_ = 0;
+    size_t batch_ = 0;
+    std::exception_ptr error_;
+    bool stop_ = false;
+  };
+
+  // Splits input into at most num_chunks chunks of roughly equal size, each ending after a '\n'
+  // (except possibly the last one). Concatenating the chunks gives input.
+  std::vector<std::string_view> split_into_chunks(std::string_view input, size_t num_chunks);
+
+  // Calls parse_chunk on the chunks of input in parallel and returns the results in input order.
+  // num_chunks defaults to a few chunks per thread to balance uneven chunks.
+  template <class F>
+  auto parallel_parse_chunks(std::string_view input,
+                             F const& parse_chunk,
+                             ThreadPool& pool,
+                             size_t num_chunks = 0)
+      -> std::vector<std::invoke_result_t<F const&, std::string_view>>;
+
+  // Calls parse_line on each non-empty line of input in parallel and returns the results in
+  // input order
+  template <class F>
+  auto parallel_parse_lines(std::string_view input, F const& parse_line, ThreadPool& pool)
+      -> std::vector<std::invoke_result_t<F const&, std::string_view>>;
+
+}  // namespace cpp_utils
+
+#include "_template_definitions/parallel.tpp"
@@ -0,0 +1,53 @@
+// Area and lattice points of simple polygons with integer vertices.
+//
+// The area follows from the shoelace formula, the number of lattice points on the boundary from
+// the gcd of the edge vectors and the number of interior lattice points from Pick's theorem
+// (A = I + B / 2 - 1). The runtime is O(n) for n vertices or moves, independent of the length of
+// the edges. All sums are computed in 128-bit arithmetic. For moves they are exact as long as the
+// total path length fits into int64_t. For vertices a single shoelace term can reach 2^127, so
+// that arithmetic is checked and std::overflow_error is thrown instead of returning a wrong
+// result.
+//
+// Only simple polygons are supported: the path must not cross, touch or retrace itself, otherwise
+// the measures are meaningless (a retraced edge, for example, counts its points twice). A single
+// point is a polygon with one boundary point.
+
+#pragma once
+
+#include "coords2d.hpp"
+
+#include <utility>
+#include <vector>
+
+namespace cpp_utils {
+
+  // 128-bit integer of GCC and Clang, __extension__ silences -Wpedantic
+  __extension__ typedef __int128 PolygonInt;
+
+  struct PolygonMeasures {
+    // Twice the enclosed area, always an integer for integer vertices
+    PolygonInt twice_area = 0;
+    // Lattice points on the edges, vertices included
+    PolygonInt boundary_points = 0;
+    // Lattice points strictly inside the polygon
+    PolygonInt interior_points = 0;
+
+    // Number of cells of a grid path through the vertices, i.e. the cells of the path itself
+    // together with the cells enclosed by it
+    PolygonInt enclosed_cells() const { return interior_points + boundary_points; }
+  };
+
+  // Measures of the closed polygon through vertices, the last vertex connects back to the first.
+  // Throws std::overflow_error if the shoelace sum does not fit into 128 bits.
+  template <typename T>
+  PolygonMeasures measure_polygon(std::vector<Coords2D<T>> const& vertices);
+
+  // Measures of the polygon traced by moves from any starting point. Each move goes length steps
+  // in direction, diagonal steps change both coordinates. Throws std::invalid_argument if the
+  // moves do not return to the starting point or a length is negative.
+  template <typename T>
+  PolygonMeasures measure_polygon(std::vector<std::pair<Direction, T>> const& moves);
+
+}  // namespace cpp_utils
+
+#include "_template_definitions/polygon.tpp"
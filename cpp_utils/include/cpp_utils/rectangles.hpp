@@ -0,0 +1,52 @@
+// Area covered by axis-aligned rectangles of cells.
+//
+// A sweep line moves over the rows, a segment tree over the compressed column coordinates keeps
+// track of how often each column range is covered. The runtime is O(n log n) for n rectangles
+// (O(n k log n) for coverage of at least k), independent of the magnitude of the coordinates.
+
+#pragma once
+
+#include "coords2d.hpp"
+#include "intervals.hpp"
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace cpp_utils {
+
+  // Rectangle of cells, both corners inclusive
+  template <typename T>
+  struct Rectangle {
+    Coords2D<T> upper_left;
+    Coords2D<T> lower_right;
+  };
+
+  // Row band [first_row, last_row] together with the columns covered in each of its rows. The
+  // bands are delimited by the top and bottom edges of the rectangles. The columns are maximal
+  // runs of covered cells, so adjacent runs are joined: [1, 2] and [3, 4] become [1, 4]. Intervals
+  // itself keeps adjacent intervals apart, so an Intervals built interval by interval from the
+  // same cells may compare unequal to columns; compare contains() or total_area() instead.
+  template <typename T>
+  struct RowCoverage {
+    std::pair<T, T> rows;
+    Intervals<T> columns;
+  };
+
+  // Number of cells covered by at least one rectangle
+  template <typename T>
+  T rectangle_union_area(std::vector<Rectangle<T>> const& rectangles);
+
+  // Number of cells covered by at least k rectangles
+  template <typename T>
+  T rectangle_area_covered_at_least(std::vector<Rectangle<T>> const& rectangles, size_t k);
+
+  // Columns covered by at least k rectangles for each band of rows. Bands without any covered
+  // cell are left out.
+  template <typename T>
+  std::vector<RowCoverage<T>> rectangle_row_coverage(std::vector<Rectangle<T>> const& rectangles,
+                                                     size_t k = 1);
+
+}  // namespace cpp_utils
+
+#include "_template_definitions/rectangles.tpp"
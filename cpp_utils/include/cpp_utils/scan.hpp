@@ -0,0 +1,49 @@
+// Scanning of structured input lines with a pattern known at compile time.
+//
+// Each "{}" in the pattern is a field which is parsed into the corresponding type, all other
+// characters have to match literally:
+//
+//   auto const [x, y] = scan<"Button A: X+{}, Y+{}", int, int>(line);
+//
+// Arithmetic fields are parsed with std::from_chars, char fields take one character and
+// std::string_view fields extend up to the following literal (or the end of the line). The
+// pattern is checked and split at compile time, scanning does not allocate unless it fails.
+
+#pragma once
+
+#include "exceptions.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+namespace cpp_utils {
+
+  // Pattern passed as template argument to scan
+  template <size_t N>
+  struct ScanPattern {
+    constexpr ScanPattern(char const (&pattern)[N]) { std::copy_n(pattern, N, text); }
+
+    constexpr std::string_view view() const { return std::string_view(text, N - 1); }
+
+    char text[N]{};
+  };
+
+  // Throws ScanError if line does not match the pattern
+  template <ScanPattern Pattern, typename... Ts>
+  std::tuple<Ts...> scan(std::string_view line);
+
+  // Returns std::nullopt if line does not match the pattern
+  template <ScanPattern Pattern, typename... Ts>
+  std::optional<std::tuple<Ts...>> try_scan(std::string_view line);
+
+  // Scans each non-empty line of text. The position of a ScanError refers to text.
+  template <ScanPattern Pattern, typename... Ts>
+  std::vector<std::tuple<Ts...>> scan_lines(std::string_view text);
+
+}  // namespace cpp_utils
+
+#include "_template_definitions/scan.tpp"
@@ -1,34 +1,100 @@
 #pragma once
 
+#include "generator.hpp"
+#include "search_statistics.hpp"
+
+#include <deque>
 #include <functional>
+#include <memory>
+#include <memory_resource>
+#include <optional>
 #include <type_traits>
+#include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 namespace cpp_utils {
 
+  // Result of the eager searches: the first goal found, or all goals (distinct or not)
+  template <typename T,
+            bool FindAll,
+            bool FindAllDistinct,
+            class Hash,
+            class Allocator = std::allocator<T>>
+  using SearchResult = std::conditional_t<
+      FindAll,
+      std::conditional_t<FindAllDistinct,
+                         std::unordered_set<T, Hash, std::equal_to<T>, Allocator>,
+                         std::vector<T, Allocator>>,
+      T>;
+
+  // The eager search functions accept an optional observer (e.g. SearchStatistics) which is
+  // notified about every expansion, duplicate and goal, see search_statistics.hpp. The result and
+  // all containers used during the search (frontier and visited states) are allocated with the
+  // optional allocator, e.g. a std::pmr::polymorphic_allocator on a monotonic_buffer_resource
+  // per search.
   template <typename T,
             bool FindAll = false,
             bool FindAllDistinct = true,
-            class Hash = std::hash<T>>
-  std::conditional_t<
-      FindAll,
-      std::conditional_t<FindAllDistinct, std::unordered_set<T, Hash>, std::vector<T>>,
-      T>
+            class Hash = std::hash<T>,
+            class Observer = NoSearchObserver,
+            class Allocator = std::allocator<T>>
+  SearchResult<T, FindAll, FindAllDistinct, Hash, Allocator>
   depthFirstSearch(T start,
                    std::function<std::vector<T>(T)> const& visitAndGetSuccessors,
-                   std::function<bool(T)> const& isGoal);
+                   std::function<bool(T)> const& isGoal,
+                   Observer&& observer = {},
+                   Allocator const& allocator = Allocator());
 
   template <typename T,
             bool FindAll = false,
             bool FindAllDistinct = true,
-            class Hash = std::hash<T>>
-  std::conditional_t<
-      FindAll,
-      std::conditional_t<FindAllDistinct, std::unordered_set<T, Hash>, std::vector<T>>,
-      T>
+            class Hash = std::hash<T>,
+            class Observer = NoSearchObserver,
+            class Allocator = std::allocator<T>>
+  SearchResult<T, FindAll, FindAllDistinct, Hash, Allocator>
   breadthFirstSearch(T start,
                      std::function<std::vector<T>(T)> const& visitAndGetSuccessors,
-                     std::function<bool(T)> const& isGoal);
+                     std::function<bool(T)> const& isGoal,
+                     Observer&& observer = {},
+                     Allocator const& allocator = Allocator());
+
+  // Lazy variants which yield each goal (optionally together with its depth) as soon as it is
+  // found. The search stops when the caller stops iterating. Only the frontier is kept in memory,
+  // so goals are not deduplicated. The functions are taken by value since the search outlives the
+  // call.
+  template <typename T, bool WithDepth = false>
+  Generator<std::conditional_t<WithDepth, std::pair<T, size_t>, T>> lazyDepthFirstSearch(
+      T start,
+      std::function<std::vector<T>(T)> visitAndGetSuccessors,
+      std::function<bool(T)> isGoal);
+
+  template <typename T, bool WithDepth = false>
+  Generator<std::conditional_t<WithDepth, std::pair<T, size_t>, T>> lazyBreadthFirstSearch(
+      T start,
+      std::function<std::vector<T>(T)> visitAndGetSuccessors,
+      std::function<bool(T)> isGoal);
+
+  template <typename T,
+            class Hash = std::hash<T>,
+            class Observer = NoSearchObserver,
+            class Allocator = std::allocator<T>>
+  std::optional<std::vector<T>> bidirectionalSearch(
+      T start,
+      T goal,
+      std::function<std::vector<T>(T)> const& getSuccessors,
+      std::function<std::vector<T>(T)> const& getPredecessors,
+      Observer&& observer = {},
+      Allocator const& allocator = Allocator());
+
+  namespace pmr {
+    template <typename T,
+              bool FindAll = false,
+              bool FindAllDistinct = true,
+              class Hash = std::hash<T>>
+    using SearchResult = cpp_utils::
+        SearchResult<T, FindAll, FindAllDistinct, Hash, std::pmr::polymorphic_allocator<T>>;
+  }  // namespace pmr
 }  // namespace cpp_utils
 
 #include "_template_definitions/search.tpp"
@@ -0,0 +1,62 @@
+// Observers which can be passed to the search functions to collect statistics.
+//
+// The search functions call the observer hooks at fixed points. NoSearchObserver, the default,
+// has empty hooks only, so the compiler removes all instrumentation.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+
+namespace cpp_utils {
+
+  struct NoSearchObserver {
+    void on_search_begin() {}
+    void on_search_end() {}
+    void on_expansion_begin() {}
+    void on_expansion_end(size_t /* frontier_size */) {}
+    void on_duplicate() {}
+    void on_goal() {}
+  };
+
+  struct SearchStatistics {
+    using Clock = std::chrono::steady_clock;
+
+    // Bucket i counts expansions which took [2^(i-1), 2^i) nanoseconds (bucket 0: < 1ns)
+    static constexpr size_t num_histogram_buckets = 40;
+
+    size_t nodes_expanded = 0;
+    // States which were dropped because they had been seen before. depthFirstSearch and
+    // breadthFirstSearch keep no visited set, there it only counts goals which were already in
+    // the distinct result set (FindAllDistinct). bidirectionalSearch counts every revisited state.
+    size_t duplicate_hits = 0;
+    size_t goals_found = 0;
+    size_t peak_frontier_size = 0;
+    std::chrono::nanoseconds elapsed{0};
+    std::array<size_t, num_histogram_buckets> expansion_time_histogram{};
+
+    void on_search_begin() { search_begin_ = Clock::now(); }
+    void on_search_end() { elapsed += Clock::now() - search_begin_; }
+
+    void on_expansion_begin() { expansion_begin_ = Clock::now(); }
+    void on_expansion_end(size_t frontier_size) {
+      auto const duration = std::chrono::duration_cast<std::chrono::nanoseconds>(
+          Clock::now() - expansion_begin_);
+      auto const bucket = std::bit_width(static_cast<size_t>(duration.count()));
+      ++expansion_time_histogram[std::min<size_t>(bucket, num_histogram_buckets - 1)];
+      ++nodes_expanded;
+      peak_frontier_size = std::max(peak_frontier_size, frontier_size);
+    }
+
+    void on_duplicate() { ++duplicate_hits; }
+    void on_goal() { ++goals_found; }
+
+   private:
+    Clock::time_point search_begin_;
+    Clock::time_point expansion_begin_;
+  };
+
+}  // namespace cpp_utils
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "search_statistics.hpp"
+
+#include <fmt/core.h>
+#include <fmt/format.h>
+
+namespace fmt {
+  template <>
+  struct formatter<cpp_utils::SearchStatistics> {
+    constexpr auto parse(format_parse_context& ctx) { return ctx.begin(); }
+
+    template <typename FormatContext>
+    auto format(cpp_utils::SearchStatistics const& stats, FormatContext& ctx) const {
+      auto result = fmt::format_to(
+          ctx.out(),
+          "SearchStatistics(expanded={}, duplicates={}, goals={}, peak_frontier={}, "
+          "elapsed={}us)\n",
+          stats.nodes_expanded, stats.duplicate_hits, stats.goals_found,
+          stats.peak_frontier_size, stats.elapsed.count() / 1000);
+      // Only print non-empty buckets of the histogram
+      for (size_t bucket = 0; bucket < stats.expansion_time_histogram.size(); ++bucket) {
+        if (stats.expansion_time_histogram[bucket] == 0) {
+          continue;
+        }
+        auto const lower = bucket == 0 ? size_t{0} : size_t{1} << (bucket - 1);
+        result = fmt::format_to(ctx.out(), "  [{}ns, {}ns): {}\n", lower, size_t{1} << bucket,
+                                stats.expansion_time_histogram[bucket]);
+      }
+      return result;
+    }
+  };
+
+}  // namespace fmt
@@ -0,0 +1,100 @@
+#include <cpp_utils/grid_graph.hpp>
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+
+namespace cpp_utils {
+
+  GridGraph::GridGraph(std::tuple<size_t, size_t> dimensions,
+                       std::vector<Array2DCoords> nodes,
+                       std::vector<std::vector<GridGraphEdge>> const& adjacency)
+      : num_columns_(std::get<1>(dimensions)),
+        nodes_(std::move(nodes)),
+        node_at_cell_(std::get<0>(dimensions) * std::get<1>(dimensions), -1) {
+    if (adjacency.size() != nodes_.size()) {
+      throw std::invalid_argument("Grid graph needs one adjacency list per node");
+    }
+    edge_offsets_.reserve(nodes_.size() + 1);
+    edge_offsets_.push_back(0);
+    for (size_t node = 0; node < nodes_.size(); ++node) {
+      node_at_cell_.at(nodes_[node].row() * num_columns_ + nodes_[node].col()) =
+          static_cast<int32_t>(node);
+      edges_.insert(edges_.end(), adjacency[node].begin(), adjacency[node].end());
+      edge_offsets_.push_back(edges_.size());
+    }
+  }
+
+  std::optional<size_t> GridGraph::node_index(Array2DCoords coords) const {
+    if (coords.row() < 0 || coords.col() < 0 ||
+        static_cast<size_t>(coords.col()) >= num_columns_) {
+      return std::nullopt;
+    }
+    auto const cell = static_cast<size_t>(coords.row()) * num_columns_ + coords.col();
+    if (cell >= node_at_cell_.size() || node_at_cell_[cell] < 0) {
+      return std::nullopt;
+    }
+    return static_cast<size_t>(node_at_cell_[cell]);
+  }
+
+  std::vector<int64_t> shortest_distances(GridGraph const& graph, size_t source) {
+    std::vector<int64_t> distances(graph.num_nodes(), std::numeric_limits<int64_t>::max());
+    // Min-heap of (distance, node)
+    using Entry = std::pair<int64_t, size_t>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+    distances.at(source) = 0;
+    queue.emplace(0, source);
+    while (!queue.empty()) {
+      auto const [distance, node] = queue.top();
+      queue.pop();
+      if (distance > distances[node]) {
+        continue;
+      }
+      for (auto const& edge : graph.edges(node)) {
+        if (distance + edge.length < distances[edge.target]) {
+          distances[edge.target] = distance + edge.length;
+          queue.emplace(distances[edge.target], edge.target);
+        }
+      }
+    }
+    return distances;
+  }
+
+  std::optional<int64_t> longest_simple_path(GridGraph const& graph,
+                                             size_t source,
+                                             size_t target) {
+    // Depth-first search over all simple paths, the visited nodes are kept in a bitmask
+    if (graph.num_nodes() > 64) {
+      throw std::invalid_argument(
+          fmt::format("Longest path search supports at most 64 nodes, got {}", graph.num_nodes()));
+    }
+    if (source >= graph.num_nodes() || target >= graph.num_nodes()) {
+      throw std::out_of_range("Node index out of range");
+    }
+
+    int64_t best = -1;
+    std::function<void(size_t, uint64_t, int64_t)> visit = [&](size_t node, uint64_t visited,
+                                                               int64_t length) {
+      if (node == target) {
+        best = std::max(best, length);
+        return;
+      }
+      for (auto const& edge : graph.edges(node)) {
+        auto const bit = uint64_t{1} << edge.target;
+        if ((visited & bit) == 0) {
+          visit(edge.target, visited | bit, length + edge.length);
+        }
+      }
+    };
+    visit(source, uint64_t{1} << source, 0);
+
+    if (best < 0) {
+      return std::nullopt;
+    }
+    return best;
+  }
+
+}  // namespace cpp_utils
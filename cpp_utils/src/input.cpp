@@ -1,10 +1,255 @@
 #include <cpp_utils/input.hpp>
+#include <cpp_utils/instrumentation.hpp>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
 #include <stdexcept>
+#include <utility>
 
 namespace cpp_utils {
 
+  namespace {
+    constexpr size_t kBufferAlignment = 64;
+
+    char* allocate_aligned(size_t size) {
+      // aligned_alloc requires the size to be a multiple of the alignment
+      auto const rounded = std::max(kBufferAlignment, (size + kBufferAlignment - 1) /
+                                                          kBufferAlignment * kBufferAlignment);
+      auto* buffer = static_cast<char*>(std::aligned_alloc(kBufferAlignment, rounded));
+      if (buffer == nullptr) {
+        throw std::bad_alloc();
+      }
+      return buffer;
+    }
+
+    constexpr std::string_view kStdinName = "-";
+
+    int open_for_reading(std::string const& filename) {
+      if (filename == kStdinName) {
+        return STDIN_FILENO;
+      }
+      int const fd = ::open(filename.c_str(), O_RDONLY);
+      if (fd < 0) {
+        throw std::runtime_error(
+            fmt::format("Error opening file: {} ({})", filename, std::strerror(errno)));
+      }
+      return fd;
+    }
+
+    void check_argument_count(int argc, char* argv[]) {
+      if (argc < 2) {
+        throw std::invalid_argument(fmt::format(
+            "Not enough arguments provided. Usage: {} <filename or - for stdin>\n", argv[0]));
+      }
+    }
+  }  // namespace
+
+  InputBuffer::InputBuffer(std::string const& filename) {
+    CPP_UTILS_SCOPED_TIMER("input.open_buffer");
+    int const fd = open_for_reading(filename);
+    bool const owns_fd = fd != STDIN_FILENO;
+    struct stat file_stat {};
+    bool const is_regular = ::fstat(fd, &file_stat) == 0 && S_ISREG(file_stat.st_mode);
+    auto const file_size = is_regular ? static_cast<size_t>(file_stat.st_size) : 0;
+
+    try {
+      if (is_regular && file_size > 0) {
+        void* mapping = ::mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping != MAP_FAILED) {
+          ::madvise(mapping, file_size, MADV_SEQUENTIAL);
+          data_ = static_cast<char*>(mapping);
+          size_ = file_size;
+          mapped_ = true;
+        }
+      }
+      if (!mapped_) {
+        read_from(fd, file_size);
+      }
+    } catch (...) {
+      // No destructor runs for a partially constructed buffer
+      release();
+      if (owns_fd) {
+        ::close(fd);
+      }
+      throw;
+    }
+    // The mapping stays valid after closing the file descriptor
+    if (owns_fd) {
+      ::close(fd);
+    }
+  }
+
+  void InputBuffer::read_from(int fd, size_t size_hint) {
+    // Read everything into one aligned buffer, growing it only if the size was unknown
+    size_t capacity = std::max<size_t>(size_hint, 1 << 16);
+    data_ = allocate_aligned(capacity);
+    size_ = 0;
+    while (true) {
+      if (size_ == capacity) {
+        auto* grown = allocate_aligned(2 * capacity);
+        std::memcpy(grown, data_, size_);
+        std::free(data_);
+        data_ = grown;
+        capacity *= 2;
+      }
+      auto const num_read = ::read(fd, data_ + size_, capacity - size_);
+      if (num_read < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        release();
+        throw std::runtime_error(fmt::format("Error reading file ({})", std::strerror(errno)));
+      }
+      if (num_read == 0) {
+        break;
+      }
+      size_ += static_cast<size_t>(num_read);
+    }
+  }
+
+  InputBuffer::~InputBuffer() { release(); }
+
+  InputBuffer::InputBuffer(InputBuffer&& other) noexcept
+      : data_(std::exchange(other.data_, nullptr)),
+        size_(std::exchange(other.size_, 0)),
+        mapped_(std::exchange(other.mapped_, false)) {}
+
+  InputBuffer& InputBuffer::operator=(InputBuffer&& other) noexcept {
+    if (this != &other) {
+      release();
+      data_ = std::exchange(other.data_, nullptr);
+      size_ = std::exchange(other.size_, 0);
+      mapped_ = std::exchange(other.mapped_, false);
+    }
+    return *this;
+  }
+
+  void InputBuffer::release() {
+    if (data_ != nullptr) {
+      if (mapped_) {
+        ::munmap(data_, size_);
+      } else {
+        std::free(data_);
+      }
+    }
+    data_ = nullptr;
+    size_ = 0;
+    mapped_ = false;
+  }
+
+  InputBuffer readInputBufferGivenByArgument(const int argc, char* argv[]) {
+    check_argument_count(argc, argv);
+    return InputBuffer(argv[1]);
+  }
+
+  LineReader::LineReader(std::string const& filename, size_t buffer_size)
+      : fd_(open_for_reading(filename)),
+        owns_fd_(fd_ != STDIN_FILENO),
+        buffer_(std::max<size_t>(buffer_size, 1)) {}
+
+  LineReader::~LineReader() { close(); }
+
+  LineReader::LineReader(LineReader&& other) noexcept
+      : fd_(std::exchange(other.fd_, -1)),
+        owns_fd_(std::exchange(other.owns_fd_, false)),
+        buffer_(std::move(other.buffer_)),
+        begin_(other.begin_),
+        scanned_(other.scanned_),
+        end_(other.end_),
+        eof_(other.eof_) {}
+
+  LineReader& LineReader::operator=(LineReader&& other) noexcept {
+    if (this != &other) {
+      close();
+      fd_ = std::exchange(other.fd_, -1);
+      owns_fd_ = std::exchange(other.owns_fd_, false);
+      buffer_ = std::move(other.buffer_);
+      begin_ = other.begin_;
+      scanned_ = other.scanned_;
+      end_ = other.end_;
+      eof_ = other.eof_;
+    }
+    return *this;
+  }
+
+  void LineReader::close() {
+    if (owns_fd_ && fd_ >= 0) {
+      ::close(fd_);
+    }
+    fd_ = -1;
+    owns_fd_ = false;
+  }
+
+  std::optional<std::string_view> LineReader::next_line() {
+    while (true) {
+      auto const* const newline =
+          static_cast<char const*>(std::memchr(buffer_.data() + scanned_, '\n', end_ - scanned_));
+      if (newline != nullptr) {
+        auto const line_end = static_cast<size_t>(newline - buffer_.data());
+        auto const line = std::string_view(buffer_.data() + begin_, line_end - begin_);
+        begin_ = scanned_ = line_end + 1;
+        return line;
+      }
+      scanned_ = end_;
+      if (!fill()) {
+        if (begin_ == end_) {
+          return std::nullopt;
+        }
+        // Last line without trailing '\n'
+        auto const line = std::string_view(buffer_.data() + begin_, end_ - begin_);
+        begin_ = scanned_ = end_;
+        return line;
+      }
+    }
+  }
+
+  bool LineReader::fill() {
+    if (eof_) {
+      return false;
+    }
+    // Move the incomplete line to the front, grow only if it fills the whole buffer
+    if (begin_ > 0) {
+      std::memmove(buffer_.data(), buffer_.data() + begin_, end_ - begin_);
+      end_ -= begin_;
+      scanned_ -= begin_;
+      begin_ = 0;
+    }
+    if (end_ == buffer_.size()) {
+      buffer_.resize(2 * buffer_.size());
+    }
+    while (true) {
+      auto const num_read = ::read(fd_, buffer_.data() + end_, buffer_.size() - end_);
+      if (num_read < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        throw std::runtime_error(fmt::format("Error reading file ({})", std::strerror(errno)));
+      }
+      if (num_read == 0) {
+        eof_ = true;
+        return false;
+      }
+      end_ += static_cast<size_t>(num_read);
+      CPP_UTILS_COUNT("input.line_reader_bytes", num_read);
+      return true;
+    }
+  }
+
+  LineReader readLinesGivenByArgument(const int argc, char* argv[]) {
+    check_argument_count(argc, argv);
+    return LineReader(argv[1]);
+  }
+
   std::string readInputFileGivenByName(std::string const& filename) {
+    CPP_UTILS_SCOPED_TIMER("input.read_file");
     std::ifstream file(filename);
     if (!file) {
       throw std::runtime_error(fmt::format("Error opening file: {}", filename));
@@ -16,9 +261,11 @@ namespace cpp_utils {
   }
 
   std::string readInputFileGivenByArgument(const int argc, char* argv[]) {
-    if (argc < 2) {
-      throw std::invalid_argument(
-          fmt::format("Not enough arguments provided. Usage: {} <filename>\n", argv[0]));
+    check_argument_count(argc, argv);
+    if (argv[1] == kStdinName) {
+      std::stringstream buffer;
+      buffer << std::cin.rdbuf();
+      return buffer.str();
     }
     std::string input = readInputFileGivenByName(argv[1]);
     return input;
@@ -27,21 +274,18 @@ namespace cpp_utils {
   std::vector<std::string_view> splitString(std::string_view const& str,
                                             std::string_view const& delimiter) {
     std::vector<std::string_view> parts;
-    size_t start = 0;
-    size_t end = str.find(delimiter);
-    while (end != std::string_view::npos) {
-      if (end > start) {
-        parts.push_back(str.substr(start, end - start));
-      }
-      start = end + delimiter.size();
-      end = str.find(delimiter, start);
+    for (auto const part : split_view(str, delimiter)) {
+      parts.push_back(part);
     }
-    parts.push_back(str.substr(start, end));
     return parts;
   }
 
   std::vector<std::string_view> splitString(std::string_view const& str, char delimiter) {
-    return splitString(str, std::string(1, delimiter));
+    std::vector<std::string_view> parts;
+    for (auto const part : split_view(str, delimiter)) {
+      parts.push_back(part);
+    }
+    return parts;
   }
 
   std::string_view ltrim(std::string_view sv) {
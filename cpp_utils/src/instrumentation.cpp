@@ -0,0 +1,266 @@
+#include <cpp_utils/instrumentation.hpp>
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+namespace cpp_utils::instrumentation {
+
+  namespace {
+    constexpr std::string_view kTraceFileVariable = "CPP_UTILS_TRACE_FILE";
+
+    void update_max(std::atomic<uint64_t>& max, uint64_t value) {
+      auto current = max.load(std::memory_order_relaxed);
+      while (current < value &&
+             !max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+      }
+    }
+
+    // Small sequential thread ids keep the trace readable
+    uint32_t thread_index() {
+      static std::atomic<uint32_t> next_index = 0;
+      thread_local uint32_t const index = next_index++;
+      return index;
+    }
+
+    template <class Statistic>
+    Statistic& find_or_create(
+        std::map<std::string, std::unique_ptr<Statistic>, std::less<>>& statistics,
+        std::string_view name) {
+      auto it = statistics.find(name);
+      if (it == statistics.end()) {
+        auto statistic = std::make_unique<Statistic>();
+        statistic->name = std::string(name);
+        it = statistics.emplace(statistic->name, std::move(statistic)).first;
+      }
+      return *it->second;
+    }
+
+    std::string escape_json(std::string_view text) {
+      std::string escaped;
+      for (auto const c : text) {
+        if (c == '"' || c == '\\') {
+          escaped += '\\';
+        }
+        escaped += c;
+      }
+      return escaped;
+    }
+  }  // namespace
+
+  // Collects the trace events of one thread so that only every batch_size-th timed scope takes
+  // the registry mutex. Whatever is left is flushed when the thread exits.
+  class ThreadTraceBuffer {
+   public:
+    static constexpr size_t batch_size = 4096;
+
+    static ThreadTraceBuffer& local() {
+      thread_local ThreadTraceBuffer buffer;
+      return buffer;
+    }
+
+    ThreadTraceBuffer(ThreadTraceBuffer const&) = delete;
+    ThreadTraceBuffer& operator=(ThreadTraceBuffer const&) = delete;
+    ~ThreadTraceBuffer() { flush(); }
+
+    void add(Registry::TraceEvent const& event) {
+      events_.push_back(event);
+      if (events_.size() >= batch_size) {
+        flush();
+      }
+    }
+
+    void flush() {
+      if (!events_.empty()) {
+        Registry::instance().append_trace_events(events_);
+        events_.clear();
+      }
+    }
+
+    void clear() { events_.clear(); }
+    std::vector<Registry::TraceEvent> const& events() const { return events_; }
+
+   private:
+    ThreadTraceBuffer() = default;
+
+    std::vector<Registry::TraceEvent> events_;
+  };
+
+  void HistogramStatistic::record(uint64_t value) {
+    count.fetch_add(1, std::memory_order_relaxed);
+    sum.fetch_add(value, std::memory_order_relaxed);
+    update_max(max, value);
+    buckets[static_cast<size_t>(std::bit_width(value))].fetch_add(1, std::memory_order_relaxed);
+  }
+
+  Registry::Registry() : tracing_(std::getenv(kTraceFileVariable.data()) != nullptr) {}
+
+  Registry& Registry::instance() {
+    static Registry registry;
+    return registry;
+  }
+
+  TimerStatistic& Registry::timer(std::string_view name) {
+    std::lock_guard lock(mutex_);
+    return find_or_create(timers_, name);
+  }
+
+  CounterStatistic& Registry::counter(std::string_view name) {
+    std::lock_guard lock(mutex_);
+    return find_or_create(counters_, name);
+  }
+
+  HistogramStatistic& Registry::histogram(std::string_view name) {
+    std::lock_guard lock(mutex_);
+    return find_or_create(histograms_, name);
+  }
+
+  void Registry::record(TimerStatistic& timer, Clock::time_point start, Clock::time_point end) {
+    auto const duration =
+        static_cast<uint64_t>(std::chrono::nanoseconds(end - start).count());
+    timer.calls.fetch_add(1, std::memory_order_relaxed);
+    timer.total_ns.fetch_add(duration, std::memory_order_relaxed);
+    update_max(timer.max_ns, duration);
+
+    if (tracing()) {
+      ThreadTraceBuffer::local().add(TraceEvent{&timer, thread_index(), start, end});
+    }
+  }
+
+  void Registry::append_trace_events(std::vector<TraceEvent> const& events) {
+    std::lock_guard lock(mutex_);
+    auto const kept = std::min(events.size(), max_trace_events - trace_events_.size());
+    trace_events_.insert(trace_events_.end(), events.begin(),
+                         events.begin() + static_cast<std::ptrdiff_t>(kept));
+    dropped_trace_events_ += events.size() - kept;
+  }
+
+  std::string Registry::summary() const {
+    std::lock_guard lock(mutex_);
+    std::string result;
+    auto out = std::back_inserter(result);
+    if (!timers_.empty()) {
+      fmt::format_to(out, "{:<40} {:>12} {:>14} {:>12} {:>12}\n", "Timer", "calls",
+                     "total [ms]", "mean [us]", "max [us]");
+      for (auto const& [name, timer] : timers_) {
+        auto const calls = timer->calls.load();
+        auto const total = static_cast<double>(timer->total_ns.load());
+        fmt::format_to(out, "{:<40} {:>12} {:>14.3f} {:>12.3f} {:>12.3f}\n", name, calls,
+                       total / 1e6, calls == 0 ? 0.0 : total / 1e3 / static_cast<double>(calls),
+                       static_cast<double>(timer->max_ns.load()) / 1e3);
+      }
+    }
+    if (!counters_.empty()) {
+      fmt::format_to(out, "{:<40} {:>12}\n", "Counter", "value");
+      for (auto const& [name, counter] : counters_) {
+        fmt::format_to(out, "{:<40} {:>12}\n", name, counter->value.load());
+      }
+    }
+    if (!histograms_.empty()) {
+      fmt::format_to(out, "{:<40} {:>12} {:>14} {:>12} {:>12}\n", "Histogram", "count", "mean",
+                     "median <", "max");
+      for (auto const& [name, histogram] : histograms_) {
+        auto const count = histogram->count.load();
+        // Upper bound of the bucket containing the median
+        uint64_t median_bound = 0;
+        uint64_t seen = 0;
+        for (size_t bucket = 0; bucket < HistogramStatistic::num_buckets; ++bucket) {
+          seen += histogram->buckets[bucket].load();
+          if (2 * seen >= count) {
+            median_bound = bucket >= 64 ? UINT64_MAX : uint64_t{1} << bucket;
+            break;
+          }
+        }
+        fmt::format_to(
+            out, "{:<40} {:>12} {:>14.3f} {:>12} {:>12}\n", name, count,
+            count == 0 ? 0.0
+                       : static_cast<double>(histogram->sum.load()) / static_cast<double>(count),
+            median_bound, histogram->max.load());
+      }
+    }
+    if (dropped_trace_events_ > 0) {
+      fmt::format_to(out, "{} trace events were dropped\n", dropped_trace_events_);
+    }
+    return result;
+  }
+
+  std::string Registry::chrome_trace() const {
+    return chrome_trace(ThreadTraceBuffer::local().events());
+  }
+
+  std::string Registry::chrome_trace(std::vector<TraceEvent> const& pending) const {
+    std::lock_guard lock(mutex_);
+    std::string result = "{\"traceEvents\":[";
+    auto out = std::back_inserter(result);
+    auto const microseconds = [this](Clock::time_point time) {
+      return std::chrono::duration<double, std::micro>(time - created_).count();
+    };
+    bool first = true;
+    for (auto const* const events : {&trace_events_, &pending}) {
+      for (auto const& event : *events) {
+        fmt::format_to(out,
+                       "{}\n{{\"name\":\"{}\",\"cat\":\"cpp_utils\",\"ph\":\"X\",\"ts\":{:.3f},"
+                       "\"dur\":{:.3f},\"pid\":0,\"tid\":{}}}",
+                       first ? "" : ",", escape_json(event.timer->name),
+                       microseconds(event.start),
+                       microseconds(event.end) - microseconds(event.start), event.thread);
+        first = false;
+      }
+    }
+    result += "\n],\"displayTimeUnit\":\"ms\"}\n";
+    return result;
+  }
+
+  void Registry::reset() {
+    ThreadTraceBuffer::local().clear();
+    std::lock_guard lock(mutex_);
+    for (auto& [_, timer] : timers_) {
+      timer->calls = 0;
+      timer->total_ns = 0;
+      timer->max_ns = 0;
+    }
+    for (auto& [_, counter] : counters_) {
+      counter->value = 0;
+    }
+    for (auto& [_, histogram] : histograms_) {
+      histogram->count = 0;
+      histogram->sum = 0;
+      histogram->max = 0;
+      for (auto& bucket : histogram->buckets) {
+        bucket = 0;
+      }
+    }
+    trace_events_.clear();
+    dropped_trace_events_ = 0;
+  }
+
+  Registry::~Registry() {
+    bool const timed = std::ranges::any_of(
+        timers_, [](auto const& timer) { return timer.second->calls.load() > 0; });
+    bool const counted =
+        std::ranges::any_of(counters_,
+                            [](auto const& counter) { return counter.second->value.load() > 0; }) ||
+        std::ranges::any_of(histograms_, [](auto const& histogram) {
+          return histogram.second->count.load() > 0;
+        });
+    if (!timed && !counted) {
+      return;
+    }
+    fmt::print(stderr, "{}", summary());
+    // The buffer of this thread was flushed when its thread local storage was destroyed
+    auto const* const filename = std::getenv(kTraceFileVariable.data());
+    if (!timed || !tracing() || filename == nullptr) {
+      return;
+    }
+    std::ofstream file(filename);
+    if (file) {
+      file << chrome_trace({});
+    } else {
+      fmt::print(stderr, "Could not write trace to {}\n", filename);
+    }
+  }
+
+}  // namespace cpp_utils::instrumentation
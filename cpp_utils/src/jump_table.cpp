@@ -0,0 +1,143 @@
+#include <cpp_utils/jump_table.hpp>
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace cpp_utils {
+
+  namespace {
+
+    struct Step {
+      Array2DDim row;
+      Array2DDim col;
+    };
+
+    // Offsets in the order of the Direction enum
+    constexpr std::array<Step, 8> steps = {{
+        {0, 1},    // East
+        {1, 1},    // SouthEast
+        {1, 0},    // South
+        {1, -1},   // SouthWest
+        {0, -1},   // West
+        {-1, -1},  // NorthWest
+        {-1, 0},   // North
+        {-1, 1},   // NorthEast
+    }};
+
+    Step step_of(Direction direction) { return steps.at(static_cast<size_t>(direction)); }
+
+    // Number of steps from value in direction step until the last index before size
+    Array2DDim steps_to_border(Array2DDim value, Array2DDim step, size_t size) {
+      if (step > 0) {
+        return static_cast<Array2DDim>(size) - 1 - value;
+      }
+      if (step < 0) {
+        return value;
+      }
+      return std::numeric_limits<Array2DDim>::max();
+    }
+
+  }  // namespace
+
+  JumpTable2D::JumpTable2D(std::tuple<size_t, size_t> dimensions, std::vector<uint8_t> obstacles)
+      : num_rows_(std::get<0>(dimensions)),
+        num_columns_(std::get<1>(dimensions)),
+        obstacles_(std::move(obstacles)) {
+    if (obstacles_.size() != num_rows_ * num_columns_) {
+      throw std::invalid_argument(
+          fmt::format("Jump table of size {}x{} needs {} obstacle entries, got {}", num_rows_,
+                      num_columns_, num_rows_ * num_columns_, obstacles_.size()));
+    }
+    if (obstacles_.size() > static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+      throw std::out_of_range("Jump table supports at most INT32_MAX cells");
+    }
+    for (size_t direction = 0; direction < next_.size(); ++direction) {
+      build(static_cast<Direction>(direction));
+    }
+  }
+
+  void JumpTable2D::build(Direction direction) {
+    // A cell's next obstacle follows from the one of its neighbour in direction, so the cells
+    // are visited against direction: rows and columns are walked backwards for positive steps.
+    auto const step = step_of(direction);
+    auto const rows = static_cast<Array2DDim>(num_rows_);
+    auto const columns = static_cast<Array2DDim>(num_columns_);
+    auto& next = next_[static_cast<size_t>(direction)];
+    next.assign(obstacles_.size(), -1);
+    for (Array2DDim i = 0; i < rows; ++i) {
+      auto const row = step.row > 0 ? rows - 1 - i : i;
+      auto const neighbour_row = row + step.row;
+      for (Array2DDim j = 0; j < columns; ++j) {
+        auto const col = step.col > 0 ? columns - 1 - j : j;
+        auto const neighbour_col = col + step.col;
+        if (neighbour_row < 0 || neighbour_row >= rows || neighbour_col < 0 ||
+            neighbour_col >= columns) {
+          continue;
+        }
+        auto const neighbour = static_cast<int32_t>(neighbour_row * columns + neighbour_col);
+        next[row * columns + col] = obstacles_[neighbour] ? neighbour : next[neighbour];
+      }
+    }
+  }
+
+  size_t JumpTable2D::index(Array2DCoords coords) const {
+    if (coords.row() < 0 || coords.col() < 0 || static_cast<size_t>(coords.row()) >= num_rows_ ||
+        static_cast<size_t>(coords.col()) >= num_columns_) {
+      throw std::out_of_range(
+          fmt::format("Index ({}, {}) out of range for jump table of size {}x{}", coords.row(),
+                      coords.col(), num_rows_, num_columns_));
+    }
+    return static_cast<size_t>(coords.row()) * num_columns_ + coords.col();
+  }
+
+  std::optional<Array2DCoords> JumpTable2D::next_obstacle(Array2DCoords coords,
+                                                          Direction direction) const {
+    auto const next = next_[static_cast<size_t>(direction)][index(coords)];
+    if (next < 0) {
+      return std::nullopt;
+    }
+    return coords_of(next);
+  }
+
+  Array2DCoords JumpTable2D::slide(Array2DCoords coords, Direction direction) const {
+    auto const step = step_of(direction);
+    if (auto const obstacle = next_obstacle(coords, direction); obstacle.has_value()) {
+      return Array2DCoords{obstacle->row() - step.row, obstacle->col() - step.col};
+    }
+    auto const num_steps = std::min(steps_to_border(coords.row(), step.row, num_rows_),
+                                    steps_to_border(coords.col(), step.col, num_columns_));
+    return Array2DCoords{coords.row() + num_steps * step.row, coords.col() + num_steps * step.col};
+  }
+
+  void JumpTable2D::set_obstacle(Array2DCoords coords, bool obstacle) {
+    // For each direction only the cells behind coords (walking against the direction) up to and
+    // including the first obstacle see coords as or through their next obstacle
+    auto const cell = index(coords);
+    if ((obstacles_[cell] != 0) == obstacle) {
+      return;
+    }
+    obstacles_[cell] = obstacle ? 1 : 0;
+    auto const rows = static_cast<Array2DDim>(num_rows_);
+    auto const columns = static_cast<Array2DDim>(num_columns_);
+    for (size_t direction = 0; direction < next_.size(); ++direction) {
+      auto const step = steps[direction];
+      auto& next = next_[direction];
+      auto const target = obstacle ? static_cast<int32_t>(cell) : next[cell];
+      auto row = coords.row() - step.row;
+      auto col = coords.col() - step.col;
+      while (row >= 0 && row < rows && col >= 0 && col < columns) {
+        auto const current = row * columns + col;
+        next[current] = target;
+        if (obstacles_[current]) {
+          break;
+        }
+        row -= step.row;
+        col -= step.col;
+      }
+    }
+  }
+
+}  // namespace cpp_utils
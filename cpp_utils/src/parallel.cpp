@@ -0,0 +1,115 @@
+#include <cpp_utils/parallel.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace cpp_utils {
+
+  namespace {
+    // Pool whose worker runs on this thread, used to detect nested calls of run
+    thread_local ThreadPool const* current_pool = nullptr;
+  }  // namespace
+
+  ThreadPool::ThreadPool(size_t num_threads) {
+    num_threads = std::max<size_t>(num_threads, 1);
+    workers_.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; ++i) {
+      workers_.emplace_back([this] { work(); });
+    }
+  }
+
+  ThreadPool::~ThreadPool() {
+    {
+      std::lock_guard lock(mutex_);
+      stop_ = true;
+    }
+    batch_started_.notify_all();
+    for (auto& worker : workers_) {
+      worker.join();
+    }
+  }
+
+  void ThreadPool::run(size_t num_tasks, std::function<void(size_t)> const& task) {
+    if (num_tasks == 0) {
+      return;
+    }
+    if (current_pool == this) {
+      // Waiting for a batch from one of its own workers would deadlock, so run it inline
+      for (size_t index = 0; index < num_tasks; ++index) {
+        task(index);
+      }
+      return;
+    }
+    std::lock_guard run_lock(run_mutex_);
+    std::unique_lock lock(mutex_);
+    task_ = &task;
+    num_tasks_ = num_tasks;
+    next_task_ = 0;
+    unfinished_tasks_ = num_tasks;
+    error_ = nullptr;
+    ++batch_;
+    batch_started_.notify_all();
+    batch_finished_.wait(lock, [this] { return unfinished_tasks_ == 0; });
+    task_ = nullptr;
+    if (error_) {
+      std::rethrow_exception(std::exchange(error_, nullptr));
+    }
+  }
+
+  void ThreadPool::work() {
+    current_pool = this;
+    size_t seen_batch = 0;
+    std::unique_lock lock(mutex_);
+    while (true) {
+      batch_started_.wait(lock, [this, &seen_batch] { return stop_ || batch_ != seen_batch; });
+      if (stop_) {
+        return;
+      }
+      seen_batch = batch_;
+      while (next_task_ < num_tasks_) {
+        auto const index = next_task_++;
+        bool const skip = error_ != nullptr;
+        lock.unlock();
+        std::exception_ptr error;
+        if (!skip) {
+          try {
+            (*task_)(index);
+          } catch (...) {
+            error = std::current_exception();
+          }
+        }
+        lock.lock();
+        if (error && !error_) {
+          error_ = error;
+        }
+        if (--unfinished_tasks_ == 0) {
+          batch_finished_.notify_all();
+        }
+      }
+    }
+  }
+
+  std::vector<std::string_view> split_into_chunks(std::string_view input, size_t num_chunks) {
+    std::vector<std::string_view> chunks;
+    if (input.empty()) {
+      return chunks;
+    }
+    num_chunks = std::max<size_t>(num_chunks, 1);
+    auto const target_size = (input.size() + num_chunks - 1) / num_chunks;
+    chunks.reserve(num_chunks);
+    size_t start = 0;
+    while (start < input.size()) {
+      auto end = std::min(start + target_size, input.size());
+      if (end < input.size()) {
+        // Extend the chunk to the end of the line it stops in
+        auto const* newline = static_cast<char const*>(
+            std::memchr(input.data() + end - 1, '\n', input.size() - end + 1));
+        end = newline == nullptr ? input.size() : static_cast<size_t>(newline - input.data()) + 1;
+      }
+      chunks.push_back(input.substr(start, end - start));
+      start = end;
+    }
+    return chunks;
+  }
+
+}  // namespace cpp_utils
@@ -2,11 +2,25 @@
 #include <cpp_utils/array2d.hpp>
 #include <cpp_utils/array2d_builder.hpp>
 #include <cpp_utils/array2d_formatter.hpp>
+#include <cpp_utils/components.hpp>
+#include <cpp_utils/distance_transform.hpp>
+#include <cpp_utils/find_next.hpp>
+#include <cpp_utils/grid_graph.hpp>
+#include <cpp_utils/jump_table.hpp>
 #include <fmt/format.h>
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory_resource>
+#include <optional>
+#include <random>
+#include <stdexcept>
 #include <utility>
+#include <vector>
 
 namespace {
 
@@ -17,6 +31,20 @@ namespace {
 
   auto const default_test_vec = std::vector<int>{1, 2, 3, 4, 5, 6};
 
+  // Reproducible pseudo-random (row, column) pairs for comparing against brute force
+  std::vector<std::pair<size_t, size_t>> random_cells(size_t num_rows, size_t num_columns,
+                                                      size_t count, uint32_t seed) {
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<size_t> row_distribution(0, num_rows - 1);
+    std::uniform_int_distribution<size_t> column_distribution(0, num_columns - 1);
+    std::vector<std::pair<size_t, size_t>> cells(count);
+    for (auto& [row, col] : cells) {
+      row = row_distribution(generator);
+      col = column_distribution(generator);
+    }
+    return cells;
+  }
+
   template <>
   cpp_utils::Array2DBase<int>* CreateArray2DBase<cpp_utils::Array2D<int>>() {
     return new cpp_utils::Array2D<int>({2, 3}, default_test_vec);
@@ -430,6 +458,53 @@ namespace {
     EXPECT_EQ(array(1, 2), 3);
   }
 
+  TEST(SparseArray2DTest, PmrAllocatesFromMemoryResource) {
+    // Without an upstream resource, any allocation outside the buffer would throw
+    std::array<std::byte, 4096> buffer;
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(),
+                                              std::pmr::null_memory_resource());
+    auto const vec = std::vector<int>{0, 1, 0, 2, 0, 3};
+    cpp_utils::pmr::SparseArray2D<int> array({2, 3}, vec, 0, cpp_utils::Direction::East, &arena);
+    EXPECT_EQ(array.get_allocator().resource(), &arena);
+    EXPECT_EQ(array.size(), 3);
+    array(0, 0) = 4;
+    EXPECT_EQ(array.size(), 4);
+    EXPECT_EQ(fmt::format("{}", array), "Array2DBase(2x3)\n4 1 0\n2 0 3\n");
+  }
+
+  // Access policy tests
+  TEST(Array2DAccessTest, CheckedAccessThrowsWithIndex) {
+    cpp_utils::Array2D<int, cpp_utils::CheckedAccess> array({2, 3}, 7);
+    EXPECT_EQ(array(1, 2), 7);
+    EXPECT_THROW(array(2, 0), std::out_of_range);
+    EXPECT_THROW(array(cpp_utils::Array2DCoords{0, -1}), std::out_of_range);
+    try {
+      array(0, 3);
+      FAIL() << "Expected std::out_of_range";
+    } catch (std::out_of_range const& error) {
+      EXPECT_STREQ(error.what(), "Index (0, 3) out of range for array of size 2x3");
+    }
+  }
+
+  TEST(Array2DAccessTest, DefaultAndUncheckedPolicy) {
+    cpp_utils::Array2D<int, cpp_utils::UncheckedAccess> unchecked({2, 3}, 0);
+    unchecked(1, 2) = 5;
+    EXPECT_EQ(unchecked(1, 2), 5);
+    EXPECT_EQ(fmt::format("{}", unchecked), fmt::format("{}", [] {
+                cpp_utils::Array2D<int> array({2, 3}, 0);
+                array(1, 2) = 5;
+                return array;
+              }()));
+    if constexpr (cpp_utils::UncheckedAccess::checked) {
+      EXPECT_THROW(unchecked(2, 0), std::out_of_range);
+    }
+    cpp_utils::Array2D<int> const array({2, 3}, 0);
+    if constexpr (cpp_utils::DefaultArray2DAccess::checked) {
+      EXPECT_THROW(array(0, 3), std::out_of_range);
+      EXPECT_THROW(array.begin_row(2), std::out_of_range);
+    }
+  }
+
   // Builder tests
   TEST(Array2DBuilderTest, CreateArray2DFromString) {
     auto const input = std::string("1 2 3\n4 5 6\n");
@@ -505,4 +580,287 @@ namespace {
     EXPECT_EQ(array(1, 2), 'f');
   }
 
+  TEST(Array2DBuilderTest, CreateFromCharGridWithMarkers) {
+    auto const input = std::string("S.#\n.#E\n\n..S\n");
+    auto const grid = cpp_utils::Array2DBuilder<char>::create_from_char_grid(input, "SEx");
+    EXPECT_EQ(grid.array.num_rows(), 3);
+    EXPECT_EQ(grid.array.num_columns(), 3);
+    EXPECT_EQ(grid.array(1, 1), '#');
+    EXPECT_EQ(grid.array(2, 2), 'S');
+    EXPECT_EQ(grid.markers.at('S'), (std::vector<cpp_utils::Array2DCoords>{{0, 0}, {2, 2}}));
+    EXPECT_EQ(grid.markers.at('E'), (std::vector<cpp_utils::Array2DCoords>{{1, 2}}));
+    EXPECT_TRUE(grid.markers.at('x').empty());
+  }
+
+  TEST(Array2DBuilderTest, CreateFromCharGridConvertsEachCharacterOnce) {
+    size_t calls = 0;
+    auto const converter = [&calls](std::string_view s) {
+      ++calls;
+      return s[0] == '#' ? 1 : 0;
+    };
+    auto const grid =
+        cpp_utils::Array2DBuilder<int>::create_from_char_grid("#..\n.#.\n..#", "", converter);
+    EXPECT_EQ(calls, 2);
+    EXPECT_EQ(grid.array(2, 2), 1);
+    EXPECT_EQ(grid.array(2, 1), 0);
+    auto const digits = cpp_utils::Array2DBuilder<int>::create_from_string("12\n34\n", "\n", "");
+    EXPECT_EQ(digits(1, 0), 3);
+  }
+
+  TEST(Array2DBuilderTest, CreateFromCharGridRejectsRaggedRows) {
+    using Builder = cpp_utils::Array2DBuilder<char>;
+    EXPECT_THROW(Builder::create_from_char_grid("abc\nde\n"), std::invalid_argument);
+    EXPECT_THROW(Builder::create_from_char_grid("abc\nd\nef\n"), std::invalid_argument);
+    EXPECT_THROW(Builder::create_from_char_grid("abc\nabcd"), std::invalid_argument);
+    EXPECT_THROW(Builder::create_from_char_grid("\n\n"), std::invalid_argument);
+  }
+
+  TEST(Array2DBuilderTest, CreateFromStringCharGridPath) {
+    // One character per element with the default converter goes through create_from_char_grid
+    using Builder = cpp_utils::Array2DBuilder<char>;
+    EXPECT_THROW(Builder::create_from_string("abc\nde\n", "\n", ""), std::invalid_argument);
+
+    // Custom converters keep being called once per element
+    size_t calls = 0;
+    auto const converter = [&calls](std::string_view s) {
+      ++calls;
+      return s[0] == '#' ? 1 : 0;
+    };
+    auto const array =
+        cpp_utils::Array2DBuilder<int>::create_from_string("#..\n.#.\n", "\n", "", converter);
+    EXPECT_EQ(calls, 6);
+    EXPECT_EQ(array(1, 1), 1);
+  }
+
+  // Component labeling tests
+  TYPED_TEST(Array2DBaseTest, LabelComponentsDistinctValues) {
+    auto const labeling = cpp_utils::label_components(*(this->array_));
+    EXPECT_EQ(labeling.components.size(), 6);
+    EXPECT_EQ(labeling.labels(1, 2), 5);
+    for (auto const& info : labeling.components) {
+      EXPECT_EQ(info.area, 1);
+      EXPECT_EQ(info.perimeter, 4);
+    }
+  }
+
+  TEST(ComponentsTest, LabelComponents) {
+    auto const input = std::string("AAAA\nBBCD\nBBCC\nEEEC\n");
+    auto const array = cpp_utils::Array2DBuilder<char>::create_from_string(input, "\n", "");
+    auto const labeling = cpp_utils::label_components(array);
+    ASSERT_EQ(labeling.components.size(), 5);
+    // A, B, C, D, E in order of first appearance
+    auto const expected_areas = std::vector<size_t>{4, 4, 4, 1, 3};
+    auto const expected_perimeters = std::vector<size_t>{10, 8, 10, 4, 8};
+    for (size_t label = 0; label < 5; ++label) {
+      EXPECT_EQ(labeling.components[label].area, expected_areas[label]);
+      EXPECT_EQ(labeling.components[label].perimeter, expected_perimeters[label]);
+    }
+    EXPECT_EQ(labeling.labels(3, 3), 2);
+    EXPECT_EQ(labeling.components[2].upper_left, cpp_utils::Array2DCoords(1, 2));
+    EXPECT_EQ(labeling.components[2].lower_right, cpp_utils::Array2DCoords(3, 3));
+  }
+
+  TEST(ComponentsTest, LabelComponentsMergesUShape) {
+    // The two arms of the U only get connected in the last row
+    auto const input = std::string("X.X\nX.X\nXXX\n");
+    auto const array =
+        cpp_utils::Array2DBuilder<char>::create_sparse_from_string(input, '.', "\n", "");
+    auto const labeling = cpp_utils::label_components(array);
+    ASSERT_EQ(labeling.components.size(), 2);
+    EXPECT_EQ(labeling.labels(0, 0), labeling.labels(0, 2));
+    EXPECT_EQ(labeling.components[0].area, 7);
+    EXPECT_EQ(labeling.components[1].area, 2);
+  }
+
+  TEST(ComponentsTest, FloodFill) {
+    auto const input = std::string("X.X\nX.X\nXXX\n");
+    auto const array = cpp_utils::Array2DBuilder<char>::create_from_string(input, "\n", "");
+    auto region = cpp_utils::flood_fill(array, cpp_utils::Array2DCoords(0, 2));
+    EXPECT_EQ(region.size(), 7);
+    std::ranges::sort(region, cpp_utils::Coords2DCompare<cpp_utils::Array2DDim>());
+    EXPECT_EQ(region.front(), cpp_utils::Array2DCoords(0, 0));
+    EXPECT_EQ(region.back(), cpp_utils::Array2DCoords(2, 2));
+    EXPECT_EQ(cpp_utils::flood_fill(array, cpp_utils::Array2DCoords(1, 1)).size(), 2);
+  }
+
+  // Distance transform tests
+  TEST(DistanceTransformTest, ManhattanAndChebyshev) {
+    auto const input = std::string("....\n.#..\n....\n");
+    auto const array = cpp_utils::Array2DBuilder<char>::create_from_string(input, "\n", "");
+    auto const is_wall = [](char c) { return c == '#'; };
+    auto const manhattan = cpp_utils::distance_transform(array, is_wall);
+    EXPECT_EQ(fmt::format("{}", manhattan), "Array2DBase(3x4)\n2 1 2 3\n1 0 1 2\n2 1 2 3\n");
+    auto const chebyshev =
+        cpp_utils::distance_transform(array, is_wall, cpp_utils::DistanceMetric::Chebyshev);
+    EXPECT_EQ(fmt::format("{}", chebyshev), "Array2DBase(3x4)\n1 1 1 2\n1 0 1 2\n1 1 1 2\n");
+  }
+
+  TEST(DistanceTransformTest, MatchesBruteForce) {
+    // Pseudo-random sources on a sparse array to go through the virtual interface
+    cpp_utils::SparseArray2D<int> array(13, 17, 0);
+    for (auto const& [row, col] : random_cells(13, 17, 9, 12345)) {
+      array(row, col) = 1;
+    }
+    auto const is_source = [](int value) { return value == 1; };
+
+    for (auto const metric :
+         {cpp_utils::DistanceMetric::Manhattan, cpp_utils::DistanceMetric::Chebyshev,
+          cpp_utils::DistanceMetric::SquaredEuclidean}) {
+      auto const distances = cpp_utils::distance_transform(array, is_source, metric);
+      for (size_t row = 0; row < 13; ++row) {
+        for (size_t col = 0; col < 17; ++col) {
+          int64_t expected = cpp_utils::unreachable_distance;
+          for (auto const& [coords, _] : array.elements()) {
+            auto const dr = std::abs(static_cast<int64_t>(row) - coords.row());
+            auto const dc = std::abs(static_cast<int64_t>(col) - coords.col());
+            auto const distance = metric == cpp_utils::DistanceMetric::Manhattan ? dr + dc
+                                  : metric == cpp_utils::DistanceMetric::Chebyshev
+                                      ? std::max(dr, dc)
+                                      : dr * dr + dc * dc;
+            expected = std::min(expected, distance);
+          }
+          EXPECT_EQ(distances(row, col), expected) << row << ", " << col;
+        }
+      }
+    }
+  }
+
+  TEST(DistanceTransformTest, NoSources) {
+    cpp_utils::Array2D<int> const array({2, 3}, 0);
+    auto const distances = cpp_utils::distance_transform(
+        array, [](int value) { return value != 0; }, cpp_utils::DistanceMetric::SquaredEuclidean);
+    EXPECT_EQ(distances(1, 2), cpp_utils::unreachable_distance);
+  }
+
+  // Jump table tests
+  TEST(JumpTableTest, NextObstacleAndSlide) {
+    auto const input = std::string("....#\n.#...\n.....\n#...#\n");
+    auto const array = cpp_utils::Array2DBuilder<char>::create_from_string(input, "\n", "");
+    cpp_utils::JumpTable2D const table(array, [](char c) { return c == '#'; });
+    using cpp_utils::Array2DCoords;
+    using cpp_utils::Direction;
+    EXPECT_EQ(table.next_obstacle(Array2DCoords(0, 0), Direction::East), Array2DCoords(0, 4));
+    EXPECT_EQ(table.next_obstacle(Array2DCoords(0, 0), Direction::SouthEast), Array2DCoords(1, 1));
+    EXPECT_EQ(table.next_obstacle(Array2DCoords(0, 0), Direction::South), Array2DCoords(3, 0));
+    EXPECT_FALSE(table.next_obstacle(Array2DCoords(0, 0), Direction::North).has_value());
+    EXPECT_EQ(table.next_obstacle(Array2DCoords(2, 0), Direction::NorthEast), Array2DCoords(1, 1));
+    EXPECT_FALSE(table.next_obstacle(Array2DCoords(3, 3), Direction::NorthEast).has_value());
+    EXPECT_EQ(table.slide(Array2DCoords(1, 4), Direction::West), Array2DCoords(1, 2));
+    EXPECT_EQ(table.slide(Array2DCoords(2, 2), Direction::North), Array2DCoords(0, 2));
+    EXPECT_EQ(table.slide(Array2DCoords(3, 1), Direction::West), Array2DCoords(3, 1));
+    EXPECT_EQ(table.slide(Array2DCoords(2, 1), Direction::SouthWest), Array2DCoords(2, 1));
+    EXPECT_THROW(table.next_obstacle(Array2DCoords(4, 0), Direction::East), std::out_of_range);
+  }
+
+  TEST(JumpTableTest, UpdatesMatchRebuild) {
+    constexpr size_t num_rows = 9;
+    constexpr size_t num_columns = 11;
+    std::vector<uint8_t> obstacles(num_rows * num_columns);
+    cpp_utils::JumpTable2D table({num_rows, num_columns}, obstacles);
+    auto const cells = random_cells(num_rows, num_columns, 60, 42);
+    for (size_t update = 0; update < cells.size(); ++update) {
+      // Mostly adds obstacles, every third update clears one
+      auto const [row, col] = cells[update];
+      auto const obstacle = update % 3 != 0;
+      obstacles[row * num_columns + col] = obstacle;
+      table.set_obstacle(cpp_utils::Array2DCoords(row, col), obstacle);
+
+      cpp_utils::JumpTable2D const rebuilt({num_rows, num_columns}, obstacles);
+      for (size_t r = 0; r < num_rows; ++r) {
+        for (size_t c = 0; c < num_columns; ++c) {
+          for (int direction = 0; direction < 8; ++direction) {
+            auto const coords = cpp_utils::Array2DCoords(r, c);
+            auto const d = static_cast<cpp_utils::Direction>(direction);
+            ASSERT_EQ(table.next_obstacle(coords, d), rebuilt.next_obstacle(coords, d));
+          }
+        }
+      }
+    }
+  }
+
+  // find_next tests
+  TEST(FindNextTest, DenseRowsAndColumns) {
+    auto const input = std::string("a..b.\n.....\nb.a..\n....a\n");
+    auto const array = cpp_utils::Array2DBuilder<char>::create_from_string(input, "\n", "");
+    using cpp_utils::Array2DCoords;
+    using cpp_utils::Direction;
+    EXPECT_EQ(cpp_utils::find_next(array, Array2DCoords(0, 0), Direction::East, 'b'),
+              Array2DCoords(0, 3));
+    EXPECT_EQ(cpp_utils::find_next(array, Array2DCoords(0, 3), Direction::West, 'a'),
+              Array2DCoords(0, 0));
+    EXPECT_FALSE(cpp_utils::find_next(array, Array2DCoords(0, 0), Direction::West, 'a'));
+    EXPECT_EQ(cpp_utils::find_next(array, Array2DCoords(0, 0), Direction::South, 'b'),
+              Array2DCoords(2, 0));
+    EXPECT_EQ(cpp_utils::find_next(array, Array2DCoords(0, 0), Direction::SouthEast, 'a'),
+              Array2DCoords(2, 2));
+    auto const is_letter = [](char c) { return c != '.'; };
+    EXPECT_EQ(cpp_utils::find_next(array, Array2DCoords(3, 2), Direction::North, is_letter),
+              Array2DCoords(2, 2));
+    EXPECT_THROW(cpp_utils::find_next(array, Array2DCoords(4, 0), Direction::East, 'a'),
+                 std::out_of_range);
+  }
+
+  TEST(FindNextTest, MatchesIteratorScan) {
+    // Tall enough for several blocks of rows in the column scan
+    constexpr size_t num_rows = 37;
+    constexpr size_t num_columns = 23;
+    cpp_utils::Array2D<int> dense({num_rows, num_columns}, 0);
+    cpp_utils::Array2D<char> bytes({num_rows, num_columns}, '.');
+    cpp_utils::SparseArray2D<int> sparse(num_rows, num_columns, 0);
+    for (auto const& [row, col] : random_cells(num_rows, num_columns, 60, 7)) {
+      dense(row, col) = 1;
+      bytes(row, col) = '#';
+      sparse(row, col) = 1;
+    }
+
+    for (size_t row = 0; row < num_rows; ++row) {
+      for (size_t col = 0; col < num_columns; ++col) {
+        auto const coords = cpp_utils::Array2DCoords(row, col);
+        for (int direction = 0; direction < 8; ++direction) {
+          auto const d = static_cast<cpp_utils::Direction>(direction);
+          std::optional<cpp_utils::Array2DCoords> expected;
+          for (auto next = coords.step_towards_direction(d); dense.is_valid_index(next);
+               next = next.step_towards_direction(d)) {
+            if (dense(next) == 1) {
+              expected = next;
+              break;
+            }
+          }
+          ASSERT_EQ(cpp_utils::find_next(dense, coords, d, 1), expected);
+          ASSERT_EQ(cpp_utils::find_next(bytes, coords, d, '#'), expected);
+          ASSERT_EQ(cpp_utils::find_next(sparse, coords, d, 1), expected);
+        }
+      }
+    }
+  }
+
+  // Grid graph tests
+  TEST(GridGraphTest, ContractsCorridors) {
+    // Start (0, 1), end (6, 5) and five junctions, (2, 3) and (2, 5) are connected twice
+    auto const input = std::string(
+        "#.#####\n"
+        "#.#...#\n"
+        "#.....#\n"
+        "#.#.#.#\n"
+        "#.....#\n"
+        "#####.#\n"
+        "#####.#\n");
+    auto const array = cpp_utils::Array2DBuilder<char>::create_from_string(input, "\n", "");
+    auto const start = cpp_utils::Array2DCoords(0, 1);
+    auto const end = cpp_utils::Array2DCoords(6, 5);
+    auto const graph =
+        cpp_utils::contract_grid(array, [](char c) { return c != '#'; }, {start, end});
+
+    auto const source = graph.node_index(start);
+    auto const target = graph.node_index(end);
+    ASSERT_TRUE(source.has_value());
+    ASSERT_TRUE(target.has_value());
+    EXPECT_FALSE(graph.node_index(cpp_utils::Array2DCoords(1, 1)).has_value());
+    EXPECT_EQ(graph.edges(*source).size(), 1);
+
+    auto const distances = cpp_utils::shortest_distances(graph, *source);
+    EXPECT_EQ(distances[*target], 10);
+    EXPECT_EQ(cpp_utils::longest_simple_path(graph, *source, *target), 16);
+  }
+
 }  // namespace
@@ -0,0 +1,309 @@
+#include <cpp_utils/array2d_builder.hpp>
+#include <cpp_utils/input.hpp>
+#include <cpp_utils/integers.hpp>
+#include <cpp_utils/scan.hpp>
+#include <fcntl.h>
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace {
+
+  // Writes content to a temporary file which is removed again at the end of the test. The name
+  // is made unique by mkstemp, since ctest runs the tests concurrently in separate processes.
+  class TemporaryFile {
+   public:
+    explicit TemporaryFile(std::string const& content) {
+      auto path =
+          (std::filesystem::temp_directory_path() / "cpp_utils_test_input_XXXXXX").string();
+      int const fd = ::mkstemp(path.data());
+      if (fd < 0) {
+        throw std::runtime_error("Cannot create temporary file " + path);
+      }
+      ::close(fd);
+      path_ = path;
+      std::ofstream file(path_, std::ios::binary);
+      file << content;
+    }
+    ~TemporaryFile() { std::filesystem::remove(path_); }
+
+    std::string path() const { return path_.string(); }
+
+   private:
+    std::filesystem::path path_;
+  };
+
+  TEST(InputBufferTest, MapsFile) {
+    TemporaryFile const file("1 2 3\n4 5 6\n");
+    cpp_utils::InputBuffer const buffer(file.path());
+    EXPECT_TRUE(buffer.is_memory_mapped());
+    EXPECT_EQ(buffer.view(), "1 2 3\n4 5 6\n");
+    EXPECT_EQ(cpp_utils::readInputFileGivenByName(file.path()), buffer.view());
+
+    // Can be passed to the parsers directly
+    EXPECT_EQ(cpp_utils::splitString(buffer, "\n").size(), 3);
+    auto const array = cpp_utils::Array2DBuilder<int>::create_from_string(buffer);
+    EXPECT_EQ(array(1, 2), 6);
+  }
+
+  TEST(InputBufferTest, EmptyFile) {
+    TemporaryFile const file("");
+    cpp_utils::InputBuffer const buffer(file.path());
+    EXPECT_EQ(buffer.size(), 0);
+    EXPECT_EQ(buffer.view(), "");
+  }
+
+  TEST(InputBufferTest, Move) {
+    TemporaryFile const file("abc");
+    cpp_utils::InputBuffer buffer(file.path());
+    cpp_utils::InputBuffer moved(std::move(buffer));
+    EXPECT_EQ(moved.view(), "abc");
+    EXPECT_EQ(buffer.size(), 0);
+  }
+
+  TEST(InputBufferTest, MissingFileThrows) {
+    EXPECT_THROW(cpp_utils::InputBuffer("/nonexistent/cpp_utils_input.txt"), std::runtime_error);
+  }
+
+  // Redirects stdin to a file for the lifetime of the object
+  class StdinRedirect {
+   public:
+    explicit StdinRedirect(std::string const& path) : saved_(::dup(STDIN_FILENO)) {
+      int const fd = ::open(path.c_str(), O_RDONLY);
+      ::dup2(fd, STDIN_FILENO);
+      ::close(fd);
+    }
+    ~StdinRedirect() {
+      ::dup2(saved_, STDIN_FILENO);
+      ::close(saved_);
+    }
+
+   private:
+    int saved_;
+  };
+
+  std::vector<std::string> read_lines(cpp_utils::LineReader& reader) {
+    std::vector<std::string> lines;
+    for (auto const line : reader) {
+      lines.emplace_back(line);
+    }
+    return lines;
+  }
+
+  using Lines = std::vector<std::string>;
+
+  TEST(LineReaderTest, LinesAcrossBufferBoundaries) {
+    TemporaryFile const file("first line\n\nx\na much longer line than the buffer\nlast");
+    for (size_t buffer_size : {1, 3, 7, 1 << 16}) {
+      cpp_utils::LineReader reader(file.path(), buffer_size);
+      EXPECT_EQ(read_lines(reader),
+                (Lines{"first line", "", "x", "a much longer line than the buffer", "last"}));
+      EXPECT_FALSE(reader.next_line());
+    }
+  }
+
+  TEST(LineReaderTest, TrailingNewlineAndEmptyFile) {
+    TemporaryFile const file("a\nb\n");
+    cpp_utils::LineReader reader(file.path(), 2);
+    EXPECT_EQ(read_lines(reader), (Lines{"a", "b"}));
+    TemporaryFile const empty("");
+    cpp_utils::LineReader empty_reader(empty.path());
+    EXPECT_TRUE(read_lines(empty_reader).empty());
+    EXPECT_THROW(cpp_utils::LineReader("/nonexistent/cpp_utils_input.txt"), std::runtime_error);
+  }
+
+  TEST(LineReaderTest, ReducesLargeInput) {
+    std::string content;
+    int64_t expected = 0;
+    for (int64_t i = 0; i < 100000; ++i) {
+      content += std::to_string(i) + "\n";
+      expected += i;
+    }
+    TemporaryFile const file(content);
+    cpp_utils::LineReader reader(file.path(), 4096);
+    int64_t sum = 0;
+    for (auto const line : reader) {
+      sum += cpp_utils::extract_integers(line).at(0);
+    }
+    EXPECT_EQ(sum, expected);
+  }
+
+  TEST(LineReaderTest, ReadsStdin) {
+    TemporaryFile const file("from\nstdin\n");
+    std::string program = "program";
+    std::string dash = "-";
+    char* argv[] = {program.data(), dash.data()};
+    {
+      StdinRedirect const redirect(file.path());
+      auto reader = cpp_utils::readLinesGivenByArgument(2, argv);
+      EXPECT_EQ(read_lines(reader), (Lines{"from", "stdin"}));
+    }
+    {
+      StdinRedirect const redirect(file.path());
+      EXPECT_EQ(cpp_utils::readInputBufferGivenByArgument(2, argv).view(), "from\nstdin\n");
+    }
+  }
+
+  std::vector<std::string_view> collect(cpp_utils::SplitView const& view) {
+    std::vector<std::string_view> parts;
+    for (auto const part : view) {
+      parts.push_back(part);
+    }
+    return parts;
+  }
+
+  using Parts = std::vector<std::string_view>;
+
+  TEST(SplitViewTest, SkipsEmptyFieldsButKeepsLast) {
+    EXPECT_EQ(collect(cpp_utils::split_view("a,,b,c", ',')), (Parts{"a", "b", "c"}));
+    EXPECT_EQ(collect(cpp_utils::split_view(",a,", ',')), (Parts{"a", ""}));
+    EXPECT_EQ(collect(cpp_utils::split_view("", ',')), (Parts{""}));
+    EXPECT_EQ(collect(cpp_utils::split_view("abc", ',')), (Parts{"abc"}));
+  }
+
+  TEST(SplitViewTest, MultiByteDelimiter) {
+    EXPECT_EQ(collect(cpp_utils::split_view("a, b, , c", ", ")), (Parts{"a", "b", "c"}));
+    EXPECT_EQ(collect(cpp_utils::split_view("block1\n\nblock2\n\n", "\n\n")),
+              (Parts{"block1", "block2", ""}));
+    EXPECT_THROW(cpp_utils::split_view("abc", ""), std::invalid_argument);
+  }
+
+  TEST(SplitViewTest, SplitStringFields) {
+    // splitString is built on split_view, so both are checked against literal fields
+    std::vector<std::pair<std::string_view, Parts>> const cases = {
+        {"1 2  3\n4 5 6\n", {"1", "2", "3\n4", "5", "6\n"}},
+        {"  x", {"x"}},
+        {"x  ", {"x", ""}},
+        {" ", {""}},
+        {"", {""}},
+        {"a b", {"a", "b"}},
+    };
+    for (auto const& [input, expected] : cases) {
+      EXPECT_EQ(cpp_utils::splitString(input, ' '), expected) << input;
+      EXPECT_EQ(cpp_utils::splitString(input, " "), expected) << input;
+      EXPECT_EQ(collect(cpp_utils::split_view(input, ' ')), expected) << input;
+    }
+    EXPECT_EQ(cpp_utils::splitString("--a----b--", "--"), (Parts{"a", "b", ""}));
+    EXPECT_EQ(cpp_utils::splitString("-a-", '-'), (Parts{"a", ""}));
+  }
+
+  TEST(SplitViewTest, Nested) {
+    size_t sum = 0;
+    for (auto const line : cpp_utils::split_view("1 2\n3 4\n", '\n')) {
+      for (auto const field : cpp_utils::split_view(line, ' ')) {
+        if (!field.empty()) {
+          sum += static_cast<size_t>(field[0] - '0');
+        }
+      }
+    }
+    EXPECT_EQ(sum, 10);
+  }
+
+  TEST(ExtractIntegersTest, SignsAndSeparators) {
+    EXPECT_EQ(cpp_utils::extract_integers("p=0,4 v=3,-3"), (std::vector<int64_t>{0, 4, 3, -3}));
+    EXPECT_EQ(cpp_utils::extract_integers("1-2 -x 7--8"), (std::vector<int64_t>{1, -2, 7, -8}));
+    EXPECT_EQ(cpp_utils::extract_integers<uint32_t>("1-2"), (std::vector<uint32_t>{1, 2}));
+    EXPECT_TRUE(cpp_utils::extract_integers("no numbers - here").empty());
+    EXPECT_TRUE(cpp_utils::extract_integers("").empty());
+  }
+
+  TEST(ExtractIntegersTest, LongRunsAndLimits) {
+    // Long enough for the vectorized classification and the eight digit conversion
+    EXPECT_EQ(cpp_utils::extract_integers("Button A: X+123456789012, Y=-98765432109876543"),
+              (std::vector<int64_t>{123456789012, -98765432109876543}));
+    EXPECT_EQ(cpp_utils::extract_integers("9223372036854775807 -9223372036854775808"),
+              (std::vector<int64_t>{std::numeric_limits<int64_t>::max(),
+                                    std::numeric_limits<int64_t>::min()}));
+    EXPECT_EQ(cpp_utils::extract_integers<int32_t>("00000000000000000000042"),
+              (std::vector<int32_t>{42}));
+    EXPECT_EQ(cpp_utils::extract_integers<int8_t>("-128 127"), (std::vector<int8_t>{-128, 127}));
+    EXPECT_THROW(cpp_utils::extract_integers<int32_t>("2147483648"), std::out_of_range);
+    EXPECT_THROW(cpp_utils::extract_integers<int8_t>("200"), std::out_of_range);
+  }
+
+  TEST(ExtractIntegersTest, MatchesScalarReference) {
+    std::string text;
+    std::vector<int64_t> expected;
+    for (int64_t i = 0; i < 1000; ++i) {
+      auto const value = (i % 2 == 0 ? 1 : -1) * i * i * i * 7919;
+      expected.push_back(value);
+      text += std::to_string(value) + std::string(static_cast<size_t>(i % 5), ' ') + ",";
+    }
+    EXPECT_EQ(cpp_utils::extract_integers(text), expected);
+  }
+
+  TEST(ExtractIntegersTest, IntoSpan) {
+    std::array<int, 4> out{};
+    EXPECT_EQ(cpp_utils::extract_integers(std::string_view("1 2 3"), std::span<int>(out)), 3);
+    EXPECT_EQ(out, (std::array<int, 4>{1, 2, 3, 0}));
+    EXPECT_THROW(cpp_utils::extract_integers(std::string_view("1 2 3 4 5"), std::span<int>(out)),
+                 std::length_error);
+  }
+
+  TEST(ExtractIntegersTest, PerLine) {
+    using Lines = std::vector<std::vector<int64_t>>;
+    EXPECT_EQ(cpp_utils::extract_integers_per_line("1 2\n\n-3\n"), (Lines{{1, 2}, {}, {-3}}));
+    EXPECT_EQ(cpp_utils::extract_integers_per_line("4,5"), (Lines{{4, 5}}));
+    EXPECT_TRUE(cpp_utils::extract_integers_per_line("").empty());
+  }
+
+  TEST(ScanTest, ParsesFields) {
+    auto const [x, y] = cpp_utils::scan<"Button A: X+{}, Y+{}", int, int>("Button A: X+94, Y+34");
+    EXPECT_EQ(x, 94);
+    EXPECT_EQ(y, 34);
+    EXPECT_EQ((cpp_utils::scan<"p={},{} v={},{}", int, int, int, int>("p=0,4 v=3,-3")),
+              std::make_tuple(0, 4, 3, -3));
+    EXPECT_EQ((cpp_utils::scan<"{} -> {}: {}", std::string_view, char, double>("abc -> x: 2.5")),
+              std::make_tuple(std::string_view("abc"), 'x', 2.5));
+    EXPECT_EQ((cpp_utils::scan<"{}", std::string_view>("rest of line")),
+              std::make_tuple(std::string_view("rest of line")));
+    EXPECT_EQ((cpp_utils::scan<"no fields">("no fields")), std::tuple<>());
+  }
+
+  TEST(ScanTest, ReportsPositionOfMismatch) {
+    auto const position_of_error = [](auto const& scan) -> size_t {
+      try {
+        scan();
+      } catch (cpp_utils::ScanError const& error) {
+        return error.position();
+      }
+      return std::string_view::npos;
+    };
+    // Literal mismatch
+    EXPECT_EQ(position_of_error([] { cpp_utils::scan<"p={},{}", int, int>("p=1;2"); }), 3);
+    // Field which is no number
+    EXPECT_EQ(position_of_error([] { cpp_utils::scan<"p={},{}", int, int>("p=1,x"); }), 4);
+    // Trailing input
+    EXPECT_EQ(position_of_error([] { cpp_utils::scan<"p={}", int>("p=12 "); }), 4);
+    // Out of range
+    EXPECT_EQ(position_of_error([] { cpp_utils::scan<"{}", uint8_t>("256"); }), 0);
+    EXPECT_FALSE((cpp_utils::try_scan<"p={}", int>("q=1")));
+    EXPECT_EQ((cpp_utils::try_scan<"p={}", int>("p=1")), std::make_tuple(1));
+  }
+
+  TEST(ScanTest, ScanLines) {
+    auto const values = cpp_utils::scan_lines<"{}-{}", int, int>("1-2\n\n3-4\n");
+    EXPECT_EQ(values, (std::vector<std::tuple<int, int>>{{1, 2}, {3, 4}}));
+    try {
+      cpp_utils::scan_lines<"{}-{}", int, int>("1-2\n3+4\n");
+      FAIL() << "Expected ScanError";
+    } catch (cpp_utils::ScanError const& error) {
+      EXPECT_EQ(error.position(), 5);
+    }
+  }
+
+}  // namespace
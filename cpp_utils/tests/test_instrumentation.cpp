@@ -0,0 +1,124 @@
+#include <cpp_utils/array2d_builder.hpp>
+#include <cpp_utils/instrumentation.hpp>
+#include <cpp_utils/intervals.hpp>
+#include <cpp_utils/search.hpp>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+  using cpp_utils::instrumentation::Registry;
+
+#if defined(CPP_UTILS_INSTRUMENTATION) && CPP_UTILS_INSTRUMENTATION
+  constexpr bool kEnabled = true;
+#else
+  constexpr bool kEnabled = false;
+#endif
+
+  class InstrumentationTest : public ::testing::Test {
+   protected:
+    void SetUp() override { Registry::instance().reset(); }
+    // Keeps the summary and trace from being written at exit
+    void TearDown() override {
+      Registry::instance().set_tracing(false);
+      Registry::instance().reset();
+    }
+  };
+
+  void timed_function() { CPP_UTILS_SCOPED_TIMER("test.timed_function"); }
+
+  TEST_F(InstrumentationTest, MacrosRecordOnlyIfEnabled) {
+    for (int i = 0; i < 3; ++i) {
+      timed_function();
+      CPP_UTILS_COUNT("test.counter", 2);
+      CPP_UTILS_HISTOGRAM("test.histogram", 100 * i);
+    }
+    auto& registry = Registry::instance();
+    EXPECT_EQ(registry.timer("test.timed_function").calls, kEnabled ? 3 : 0);
+    EXPECT_EQ(registry.counter("test.counter").value, kEnabled ? 6 : 0);
+    EXPECT_EQ(registry.histogram("test.histogram").count, kEnabled ? 3 : 0);
+    EXPECT_EQ(registry.histogram("test.histogram").max, kEnabled ? 200 : 0);
+  }
+
+  TEST_F(InstrumentationTest, LibraryEntryPointsAreInstrumented) {
+    auto const array = cpp_utils::Array2DBuilder<char>::create_from_string("ab\ncd\n", "\n", "");
+    cpp_utils::Intervals<int64_t> const intervals({{5, 7}, {1, 3}});
+    auto const found = cpp_utils::breadthFirstSearch<int64_t>(
+        0, [](int64_t n) { return n < 5 ? std::vector<int64_t>{n + 1} : std::vector<int64_t>{}; },
+        [](int64_t n) { return n == 5; });
+    EXPECT_EQ(found, 5);
+    auto& registry = Registry::instance();
+    EXPECT_EQ(registry.timer("array2d_builder.create_from_string").calls, kEnabled ? 1 : 0);
+    EXPECT_EQ(registry.timer("intervals.sort_and_merge").calls, kEnabled ? 1 : 0);
+    EXPECT_EQ(registry.counter("search.expansions").value, kEnabled ? 5 : 0);
+  }
+
+  TEST_F(InstrumentationTest, RegistryStatistics) {
+    auto& registry = Registry::instance();
+    auto& counter = registry.counter("test.registry_counter");
+    EXPECT_EQ(&counter, &registry.counter("test.registry_counter"));
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+      threads.emplace_back([&counter] {
+        for (int i = 0; i < 1000; ++i) {
+          counter.add(1);
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    EXPECT_EQ(counter.value, 4000);
+
+    auto& histogram = registry.histogram("test.registry_histogram");
+    for (uint64_t value : {0, 1, 2, 3, 1000}) {
+      histogram.record(value);
+    }
+    EXPECT_EQ(histogram.count, 5);
+    EXPECT_EQ(histogram.sum, 1006);
+    EXPECT_EQ(histogram.buckets[0], 1);
+    EXPECT_EQ(histogram.buckets[2], 2);
+    EXPECT_EQ(histogram.buckets[10], 1);
+
+    registry.set_tracing(true);
+    {
+      cpp_utils::instrumentation::ScopedTimer const timer(registry.timer("test.registry_timer"));
+    }
+    EXPECT_EQ(registry.timer("test.registry_timer").calls, 1);
+    auto const summary = registry.summary();
+    EXPECT_NE(summary.find("test.registry_counter"), std::string::npos);
+    EXPECT_NE(summary.find("4000"), std::string::npos);
+    auto const trace = registry.chrome_trace();
+    EXPECT_NE(trace.find("\"name\":\"test.registry_timer\""), std::string::npos);
+    EXPECT_NE(trace.find("\"ph\":\"X\""), std::string::npos);
+  }
+
+  TEST_F(InstrumentationTest, TraceEventsAreBufferedPerThread) {
+    auto& registry = Registry::instance();
+    auto& timer = registry.timer("test.thread_timer");
+    registry.set_tracing(false);
+    { cpp_utils::instrumentation::ScopedTimer const scoped(registry.timer("test.untraced")); }
+    EXPECT_EQ(registry.chrome_trace().find("test.untraced"), std::string::npos);
+
+    registry.set_tracing(true);
+    std::thread([&timer] {
+      for (int i = 0; i < 5000; ++i) {
+        cpp_utils::instrumentation::ScopedTimer const scoped(timer);
+      }
+    }).join();
+    EXPECT_EQ(timer.calls, 5000);
+    auto const trace = registry.chrome_trace();
+    size_t events = 0;
+    for (auto pos = trace.find("test.thread_timer"); pos != std::string::npos;
+         pos = trace.find("test.thread_timer", pos + 1)) {
+      ++events;
+    }
+    // One full batch was flushed while the thread ran, the rest when it exited
+    EXPECT_EQ(events, 5000);
+  }
+
+}  // namespace
@@ -0,0 +1,269 @@
+#include <cpp_utils/interval_map.hpp>
+#include <cpp_utils/intervals.hpp>
+#include <cpp_utils/rectangles.hpp>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace {
+
+  using Intervals = cpp_utils::Intervals<int64_t>;
+  using IntervalList = std::vector<Intervals::Interval>;
+
+  TEST(IntervalsTest, InsertMergesOverlapping) {
+    Intervals intervals;
+    intervals.insert_interval(10, 20);
+    intervals.insert_interval(30, 40);
+    intervals.insert_interval(1, 2);
+    EXPECT_EQ(intervals.intervals(), (IntervalList{{1, 2}, {10, 20}, {30, 40}}));
+    intervals.insert_interval(15, 35);
+    EXPECT_EQ(intervals.intervals(), (IntervalList{{1, 2}, {10, 40}}));
+    // Adjacent intervals are not merged
+    intervals.insert_interval(3, 5);
+    EXPECT_EQ(intervals.intervals(), (IntervalList{{1, 2}, {3, 5}, {10, 40}}));
+    EXPECT_EQ(intervals.total_area(), 2 + 3 + 31);
+  }
+
+  TEST(IntervalsTest, InsertRejectsInvalidInterval) {
+    Intervals intervals;
+    EXPECT_THROW(intervals.insert_interval(5, 4), std::invalid_argument);
+    EXPECT_THROW(Intervals(IntervalList{{5, 4}}), std::invalid_argument);
+  }
+
+  TEST(IntervalsTest, Contains) {
+    Intervals const intervals(IntervalList{{10, 20}, {30, 40}});
+    EXPECT_FALSE(intervals.contains(9));
+    EXPECT_TRUE(intervals.contains(10));
+    EXPECT_TRUE(intervals.contains(20));
+    EXPECT_FALSE(intervals.contains(25));
+    EXPECT_TRUE(intervals.contains(40));
+    EXPECT_FALSE(intervals.contains(41));
+  }
+
+  TEST(IntervalsTest, BatchContains) {
+    Intervals const intervals(IntervalList{{10, 20}, {30, 40}, {50, 50}});
+    std::vector<int64_t> values;
+    for (int64_t value = 55; value >= 0; value -= 3) {
+      values.push_back(value);
+    }
+    std::vector<bool> expected;
+    for (auto const value : values) {
+      expected.push_back(intervals.contains(value));
+    }
+    // Unsorted values
+    EXPECT_EQ(intervals.contains(std::span<int64_t const>(values)), expected);
+    EXPECT_EQ(intervals.count_contained(values), std::ranges::count(expected, true));
+    // Sorted values
+    std::ranges::reverse(values);
+    std::reverse(expected.begin(), expected.end());
+    EXPECT_EQ(intervals.contains(std::span<int64_t const>(values)), expected);
+    EXPECT_EQ(intervals.count_contained(values), std::ranges::count(expected, true));
+    EXPECT_EQ(Intervals().count_contained(values), 0);
+  }
+
+  TEST(IntervalsTest, BulkConstructionSortsAndMerges) {
+    Intervals const intervals(IntervalList{{30, 40}, {1, 5}, {3, 8}, {35, 50}, {20, 20}});
+    EXPECT_EQ(intervals.intervals(), (IntervalList{{1, 8}, {20, 20}, {30, 50}}));
+  }
+
+  TEST(IntervalsTest, DeferredInsert) {
+    Intervals intervals(IntervalList{{10, 20}});
+    intervals.insert_interval_deferred(30, 40);
+    intervals.insert_interval_deferred(5, 12);
+    intervals.insert_interval_deferred(38, 45);
+    // The first query merges the deferred intervals
+    EXPECT_TRUE(intervals.contains(42));
+    EXPECT_EQ(intervals.intervals(), (IntervalList{{5, 20}, {30, 45}}));
+    intervals.insert_interval_deferred(0, 100);
+    EXPECT_EQ(intervals.total_area(), 101);
+    intervals.insert_interval_deferred(200, 200);
+    intervals.flush();
+    EXPECT_EQ(intervals.intervals(), (IntervalList{{0, 100}, {200, 200}}));
+  }
+
+  TEST(IntervalsTest, Union) {
+    Intervals const lhs(IntervalList{{1, 5}, {10, 20}, {40, 50}});
+    Intervals const rhs(IntervalList{{4, 12}, {30, 35}});
+    EXPECT_EQ((lhs | rhs).intervals(), (IntervalList{{1, 20}, {30, 35}, {40, 50}}));
+    auto in_place = lhs;
+    in_place |= rhs;
+    EXPECT_EQ(in_place, lhs | rhs);
+    in_place |= in_place;
+    EXPECT_EQ(in_place, lhs | rhs);
+  }
+
+  TEST(IntervalsTest, Intersection) {
+    Intervals const lhs(IntervalList{{1, 5}, {10, 20}, {40, 50}});
+    Intervals const rhs(IntervalList{{4, 12}, {15, 16}, {18, 45}});
+    EXPECT_EQ((lhs & rhs).intervals(),
+              (IntervalList{{4, 5}, {10, 12}, {15, 16}, {18, 20}, {40, 45}}));
+    auto in_place = lhs;
+    in_place &= rhs;
+    EXPECT_EQ(in_place, lhs & rhs);
+    EXPECT_EQ((lhs & Intervals()).intervals(), IntervalList{});
+  }
+
+  TEST(IntervalsTest, Difference) {
+    Intervals const lhs(IntervalList{{1, 5}, {10, 20}, {40, 50}});
+    Intervals const rhs(IntervalList{{4, 12}, {15, 16}, {18, 45}});
+    EXPECT_EQ((lhs - rhs).intervals(), (IntervalList{{1, 3}, {13, 14}, {17, 17}, {46, 50}}));
+    EXPECT_EQ((rhs - lhs).intervals(), (IntervalList{{6, 9}, {21, 39}}));
+    auto in_place = lhs;
+    in_place -= rhs;
+    EXPECT_EQ(in_place, lhs - rhs);
+    in_place -= in_place;
+    EXPECT_EQ(in_place.total_area(), 0);
+  }
+
+  TEST(IntervalsTest, Complement) {
+    Intervals const intervals(IntervalList{{1, 5}, {10, 20}, {40, 50}});
+    EXPECT_EQ(intervals.complement(0, 100).intervals(),
+              (IntervalList{{0, 0}, {6, 9}, {21, 39}, {51, 100}}));
+    EXPECT_EQ(intervals.complement(3, 45).intervals(), (IntervalList{{6, 9}, {21, 39}}));
+    EXPECT_EQ(intervals.complement(12, 18).intervals(), IntervalList{});
+    EXPECT_EQ(Intervals().complement(-3, 3).intervals(), (IntervalList{{-3, 3}}));
+  }
+
+  // Interval map tests
+  using IntervalMap = cpp_utils::IntervalMap<int64_t>;
+
+  // seed-to-soil and soil-to-fertilizer maps of the Advent of Code 2023 day 5 example
+  IntervalMap const seed_to_soil({{{98, 99}, -48}, {{50, 97}, 2}});
+  IntervalMap const soil_to_fertilizer({{{15, 51}, -15}, {{52, 53}, -15}, {{0, 14}, 39}});
+
+  TEST(IntervalMapTest, MapsValues) {
+    EXPECT_EQ(seed_to_soil(79), 81);
+    EXPECT_EQ(seed_to_soil(14), 14);
+    EXPECT_EQ(seed_to_soil(98), 50);
+    EXPECT_EQ(seed_to_soil(100), 100);
+    // The touching rules with the same offset have been merged
+    EXPECT_EQ(soil_to_fertilizer.rules().size(), 2);
+    EXPECT_EQ(soil_to_fertilizer(53), 38);
+  }
+
+  TEST(IntervalMapTest, RejectsOverlappingRules) {
+    EXPECT_THROW(IntervalMap({{{0, 10}, 1}, {{10, 20}, 2}}), std::invalid_argument);
+  }
+
+  TEST(IntervalMapTest, InsertRuleKeepsRulesNormalized) {
+    IntervalMap map;
+    map.insert_rule({20, 29}, 5);
+    map.insert_rule({0, 9}, 5);
+    map.insert_rule({40, 49}, 1);
+    // Touches both neighbours with the same offset
+    map.insert_rule({10, 19}, 5);
+    EXPECT_EQ(map.rules(), (std::vector<IntervalMap::Rule>{{{0, 29}, 5}, {{40, 49}, 1}}));
+    map.insert_rule({30, 39}, 2);
+    EXPECT_EQ(map.rules().size(), 3);
+    EXPECT_THROW(map.insert_rule({45, 50}, 1), std::invalid_argument);
+    EXPECT_THROW(map.insert_rule({-5, 0}, 1), std::invalid_argument);
+    EXPECT_THROW(map.insert_rule({60, 55}, 1), std::invalid_argument);
+
+    IntervalMap bulk;
+    bulk.insert_rules({{{40, 49}, 1}, {{10, 19}, 5}, {{30, 39}, 2}, {{0, 9}, 5}, {{20, 29}, 5}});
+    EXPECT_EQ(bulk.rules(), map.rules());
+  }
+
+  TEST(IntervalMapTest, TransformsIntervals) {
+    Intervals const seeds(IntervalList{{79, 92}, {55, 67}, {95, 100}});
+    auto const soil = seed_to_soil.transform(seeds);
+    Intervals expected;
+    for (int64_t seed = 0; seed <= 110; ++seed) {
+      if (seeds.contains(seed)) {
+        expected.insert_interval(seed_to_soil(seed), seed_to_soil(seed));
+      }
+    }
+    EXPECT_EQ(soil.total_area(), seeds.total_area());
+    for (int64_t value = 0; value <= 110; ++value) {
+      EXPECT_EQ(soil.contains(value), expected.contains(value)) << value;
+    }
+  }
+
+  TEST(IntervalMapTest, Composes) {
+    auto const seed_to_fertilizer = seed_to_soil.then(soil_to_fertilizer);
+    for (int64_t seed = -5; seed <= 110; ++seed) {
+      EXPECT_EQ(seed_to_fertilizer(seed), soil_to_fertilizer(seed_to_soil(seed))) << seed;
+    }
+    Intervals const seeds(IntervalList{{0, 120}});
+    EXPECT_EQ(seed_to_fertilizer.transform(seeds),
+              soil_to_fertilizer.transform(seed_to_soil.transform(seeds)));
+  }
+
+  // Rectangle sweep line tests
+  using Rectangle = cpp_utils::Rectangle<int64_t>;
+  using Coords = cpp_utils::Coords2D<int64_t>;
+
+  std::vector<Rectangle> const overlapping_rectangles = {
+      {Coords{0, 0}, Coords{3, 3}}, {Coords{2, 2}, Coords{5, 6}}, {Coords{3, 1}, Coords{4, 2}}};
+
+  int64_t bruteForceAreaCoveredAtLeast(std::vector<Rectangle> const& rectangles, size_t k) {
+    int64_t area = 0;
+    for (int64_t row = -1; row <= 10; ++row) {
+      for (int64_t col = -1; col <= 10; ++col) {
+        size_t count = std::ranges::count_if(rectangles, [row, col](Rectangle const& rectangle) {
+          return rectangle.upper_left.row() <= row && row <= rectangle.lower_right.row() &&
+                 rectangle.upper_left.col() <= col && col <= rectangle.lower_right.col();
+        });
+        area += count >= k;
+      }
+    }
+    return area;
+  }
+
+  TEST(RectanglesTest, UnionArea) {
+    EXPECT_EQ(cpp_utils::rectangle_union_area(overlapping_rectangles),
+              bruteForceAreaCoveredAtLeast(overlapping_rectangles, 1));
+    EXPECT_EQ(cpp_utils::rectangle_union_area(std::vector<Rectangle>{}), 0);
+  }
+
+  TEST(RectanglesTest, AreaCoveredAtLeastK) {
+    for (size_t k = 1; k <= 4; ++k) {
+      EXPECT_EQ(cpp_utils::rectangle_area_covered_at_least(overlapping_rectangles, k),
+                bruteForceAreaCoveredAtLeast(overlapping_rectangles, k))
+          << k;
+    }
+  }
+
+  TEST(RectanglesTest, HugeCoordinates) {
+    std::vector<Rectangle> const rectangles = {
+        {Coords{0, 0}, Coords{999'999'999, 999'999'999}},
+        {Coords{-1'000'000'000, 500'000'000}, Coords{499'999'999, 1'499'999'999}}};
+    EXPECT_EQ(cpp_utils::rectangle_union_area(rectangles),
+              int64_t{1'000'000'000} * 1'000'000'000 + int64_t{1'500'000'000} * 1'000'000'000 -
+                  int64_t{500'000'000} * 500'000'000);
+  }
+
+  TEST(RectanglesTest, RowCoverage) {
+    auto const coverage = cpp_utils::rectangle_row_coverage(overlapping_rectangles);
+    // Bands start at every top and below every bottom edge
+    ASSERT_EQ(coverage.size(), 5);
+    EXPECT_EQ(coverage[0].rows, std::make_pair(int64_t{0}, int64_t{1}));
+    EXPECT_EQ(coverage[0].columns.intervals(), (IntervalList{{0, 3}}));
+    EXPECT_EQ(coverage[1].rows, std::make_pair(int64_t{2}, int64_t{2}));
+    EXPECT_EQ(coverage[1].columns.intervals(), (IntervalList{{0, 6}}));
+    EXPECT_EQ(coverage[3].rows, std::make_pair(int64_t{4}, int64_t{4}));
+    EXPECT_EQ(coverage[3].columns.intervals(), (IntervalList{{1, 6}}));
+    EXPECT_EQ(coverage[4].rows, std::make_pair(int64_t{5}, int64_t{5}));
+    EXPECT_EQ(coverage[4].columns.intervals(), (IntervalList{{2, 6}}));
+
+    auto const double_coverage = cpp_utils::rectangle_row_coverage(overlapping_rectangles, 2);
+    ASSERT_EQ(double_coverage.size(), 3);
+    EXPECT_EQ(double_coverage[0].rows, std::make_pair(int64_t{2}, int64_t{2}));
+    EXPECT_EQ(double_coverage[0].columns.intervals(), (IntervalList{{2, 3}}));
+    EXPECT_EQ(double_coverage[1].rows, std::make_pair(int64_t{3}, int64_t{3}));
+    EXPECT_EQ(double_coverage[1].columns.intervals(), (IntervalList{{1, 3}}));
+    EXPECT_EQ(double_coverage[2].columns.intervals(), (IntervalList{{2, 2}}));
+
+    // Unlike insert_interval, the coverage joins adjacent runs of columns
+    auto const adjacent = cpp_utils::rectangle_row_coverage(
+        std::vector<Rectangle>{{Coords{0, 1}, Coords{0, 2}}, {Coords{0, 3}, Coords{0, 4}}});
+    ASSERT_EQ(adjacent.size(), 1);
+    EXPECT_EQ(adjacent[0].columns.intervals(), (IntervalList{{1, 4}}));
+  }
+
+}  // namespace
@@ -0,0 +1,135 @@
+#include <cpp_utils/array2d_builder.hpp>
+#include <cpp_utils/integers.hpp>
+#include <cpp_utils/parallel.hpp>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+  TEST(ThreadPoolTest, RunsEachTaskOnce) {
+    cpp_utils::ThreadPool pool(4);
+    std::vector<std::atomic<int>> calls(1000);
+    for (int batch = 0; batch < 3; ++batch) {
+      pool.run(calls.size(), [&calls](size_t i) { ++calls[i]; });
+    }
+    for (auto const& count : calls) {
+      EXPECT_EQ(count, 3);
+    }
+  }
+
+  TEST(ThreadPoolTest, RethrowsTaskException) {
+    cpp_utils::ThreadPool pool(3);
+    EXPECT_THROW(pool.run(100,
+                          [](size_t i) {
+                            if (i == 42) {
+                              throw std::runtime_error("task failed");
+                            }
+                          }),
+                 std::runtime_error);
+    // The pool is still usable afterwards
+    std::atomic<size_t> sum = 0;
+    pool.run(10, [&sum](size_t i) { sum += i; });
+    EXPECT_EQ(sum, 45);
+  }
+
+  TEST(ThreadPoolTest, NestedRunDoesNotDeadlock) {
+    cpp_utils::ThreadPool pool(2);
+    std::vector<std::atomic<int>> calls(4 * 8);
+    pool.run(4, [&pool, &calls](size_t outer) {
+      pool.run(8, [&calls, outer](size_t inner) { ++calls[outer * 8 + inner]; });
+    });
+    for (auto const& count : calls) {
+      EXPECT_EQ(count, 1);
+    }
+  }
+
+  TEST(SplitIntoChunksTest, SplitsAtLineBoundaries) {
+    std::string const input = "a\nbb\nccc\ndddd\neeeee\nlast";
+    for (size_t num_chunks = 1; num_chunks <= 8; ++num_chunks) {
+      auto const chunks = cpp_utils::split_into_chunks(input, num_chunks);
+      EXPECT_LE(chunks.size(), num_chunks);
+      std::string joined;
+      for (size_t i = 0; i < chunks.size(); ++i) {
+        EXPECT_FALSE(chunks[i].empty());
+        if (i + 1 < chunks.size()) {
+          EXPECT_EQ(chunks[i].back(), '\n');
+        }
+        joined += chunks[i];
+      }
+      EXPECT_EQ(joined, input);
+    }
+    EXPECT_TRUE(cpp_utils::split_into_chunks("", 4).empty());
+  }
+
+  TEST(ParallelParseTest, LinesInInputOrder) {
+    std::string input;
+    std::vector<int64_t> expected;
+    for (int64_t i = 0; i < 10000; ++i) {
+      input += std::to_string(i) + "," + std::to_string(-i) + "\n";
+      expected.push_back(0);
+    }
+    cpp_utils::ThreadPool pool(4);
+    auto const sums = cpp_utils::parallel_parse_lines(
+        input,
+        [](std::string_view line) {
+          auto const values = cpp_utils::extract_integers(line);
+          return values.at(0) + values.at(1);
+        },
+        pool);
+    EXPECT_EQ(sums, expected);
+
+    auto const counts = cpp_utils::parallel_parse_chunks(
+        input, [](std::string_view chunk) { return cpp_utils::extract_integers(chunk).size(); },
+        pool, 7);
+    size_t total = 0;
+    for (auto const count : counts) {
+      total += count;
+    }
+    EXPECT_EQ(total, 20000);
+  }
+
+  TEST(ParallelParseTest, CharGridMatchesSequential) {
+    std::string input;
+    for (size_t row = 0; row < 100; ++row) {
+      for (size_t col = 0; col < 37; ++col) {
+        input += (row * 37 + col) % 11 == 0 ? '#' : (row == 50 && col == 3 ? 'S' : '.');
+      }
+      input += '\n';
+    }
+    cpp_utils::ThreadPool pool(4);
+    using Builder = cpp_utils::Array2DBuilder<char>;
+    auto const sequential = Builder::create_from_char_grid(input, "S#");
+    auto const parallel = Builder::create_from_char_grid_parallel(input, pool, "S#");
+    ASSERT_EQ(parallel.array.num_rows(), sequential.array.num_rows());
+    ASSERT_EQ(parallel.array.num_columns(), sequential.array.num_columns());
+    for (size_t row = 0; row < parallel.array.num_rows(); ++row) {
+      for (size_t col = 0; col < parallel.array.num_columns(); ++col) {
+        EXPECT_EQ(parallel.array(row, col), sequential.array(row, col));
+      }
+    }
+    EXPECT_EQ(parallel.markers, sequential.markers);
+    EXPECT_EQ(parallel.markers.at('S'), (std::vector<cpp_utils::Array2DCoords>{{50, 3}}));
+
+    auto const converted = cpp_utils::Array2DBuilder<int>::create_from_char_grid_parallel(
+        input, pool, "", [](std::string_view s) { return s[0] == '#' ? 1 : 0; });
+    EXPECT_EQ(converted.array(0, 0), 1);
+    EXPECT_EQ(converted.array(0, 1), 0);
+  }
+
+  TEST(ParallelParseTest, CharGridRejectsRaggedRows) {
+    cpp_utils::ThreadPool pool(2);
+    using Builder = cpp_utils::Array2DBuilder<char>;
+    EXPECT_THROW(Builder::create_from_char_grid_parallel("abc\nde\n", pool),
+                 std::invalid_argument);
+    EXPECT_THROW(Builder::create_from_char_grid_parallel("abc\nd\nef\n", pool),
+                 std::invalid_argument);
+    EXPECT_THROW(Builder::create_from_char_grid_parallel("\n\n", pool), std::invalid_argument);
+  }
+
+}  // namespace
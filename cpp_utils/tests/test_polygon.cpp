@@ -0,0 +1,92 @@
+#include <cpp_utils/polygon.hpp>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace {
+
+  using Coords = cpp_utils::Coords2D<int64_t>;
+
+  TEST(PolygonTest, VerticesOfSquareAndTriangle) {
+    std::vector<Coords> const square = {{0, 0}, {0, 2}, {2, 2}, {2, 0}};
+    auto const measures = cpp_utils::measure_polygon(square);
+    EXPECT_EQ(static_cast<int64_t>(measures.twice_area), 8);
+    EXPECT_EQ(static_cast<int64_t>(measures.boundary_points), 8);
+    EXPECT_EQ(static_cast<int64_t>(measures.interior_points), 1);
+    EXPECT_EQ(static_cast<int64_t>(measures.enclosed_cells()), 9);
+
+    // The hypotenuse passes through 3 lattice points besides its ends
+    std::vector<Coords> const triangle = {{0, 0}, {0, 4}, {4, 0}};
+    auto const triangle_measures = cpp_utils::measure_polygon(triangle);
+    EXPECT_EQ(static_cast<int64_t>(triangle_measures.twice_area), 16);
+    EXPECT_EQ(static_cast<int64_t>(triangle_measures.boundary_points), 12);
+    EXPECT_EQ(static_cast<int64_t>(triangle_measures.interior_points), 3);
+  }
+
+  TEST(PolygonTest, TrenchMoves) {
+    using cpp_utils::Direction;
+    std::vector<std::pair<Direction, int64_t>> const moves = {
+        {Direction::East, 6},  {Direction::South, 5}, {Direction::West, 2},
+        {Direction::South, 2}, {Direction::East, 2},  {Direction::South, 2},
+        {Direction::West, 5},  {Direction::North, 2}, {Direction::West, 1},
+        {Direction::North, 2}, {Direction::East, 2},  {Direction::North, 3},
+        {Direction::West, 2},  {Direction::North, 2}};
+    EXPECT_EQ(static_cast<int64_t>(cpp_utils::measure_polygon(moves).enclosed_cells()), 62);
+
+    // Winding direction does not matter
+    std::vector<std::pair<Direction, int64_t>> reversed;
+    for (auto it = moves.rbegin(); it != moves.rend(); ++it) {
+      reversed.emplace_back(cpp_utils::reverse_direction(it->first), it->second);
+    }
+    EXPECT_EQ(static_cast<int64_t>(cpp_utils::measure_polygon(reversed).enclosed_cells()), 62);
+  }
+
+  TEST(PolygonTest, HugeMovesDoNotOverflow) {
+    using cpp_utils::Direction;
+    constexpr int64_t side = 1'000'000'000'000;
+    std::vector<std::pair<Direction, int64_t>> const moves = {{Direction::East, side},
+                                                              {Direction::South, side},
+                                                              {Direction::West, side},
+                                                              {Direction::North, side}};
+    auto const expected = static_cast<cpp_utils::PolygonInt>(side + 1) * (side + 1);
+    EXPECT_TRUE(cpp_utils::measure_polygon(moves).enclosed_cells() == expected);
+  }
+
+  TEST(PolygonTest, HugeVerticesThrowOnOverflow) {
+    constexpr int64_t max = std::numeric_limits<int64_t>::max();
+    // Twice the area is 8 * max^2, more than 2^127
+    std::vector<Coords> const square = {{-max, -max}, {-max, max}, {max, max}, {max, -max}};
+    EXPECT_THROW(cpp_utils::measure_polygon(square), std::overflow_error);
+
+    constexpr int64_t safe = int64_t{1} << 61;
+    std::vector<Coords> const safe_square = {{-safe, -safe}, {-safe, safe}, {safe, safe},
+                                             {safe, -safe}};
+    auto const side = 2 * static_cast<cpp_utils::PolygonInt>(safe);
+    EXPECT_TRUE(cpp_utils::measure_polygon(safe_square).twice_area == 2 * side * side);
+  }
+
+  TEST(PolygonTest, OpenPathThrows) {
+    using cpp_utils::Direction;
+    std::vector<std::pair<Direction, int64_t>> const moves = {{Direction::East, 3},
+                                                              {Direction::South, 3}};
+    EXPECT_THROW(cpp_utils::measure_polygon(moves), std::invalid_argument);
+    std::vector<std::pair<Direction, int64_t>> const negative = {{Direction::East, -1}};
+    EXPECT_THROW(cpp_utils::measure_polygon(negative), std::invalid_argument);
+  }
+
+  TEST(PolygonTest, SinglePoint) {
+    std::vector<Coords> const point = {{3, 4}};
+    auto const point_measures = cpp_utils::measure_polygon(point);
+    EXPECT_EQ(static_cast<int64_t>(point_measures.boundary_points), 1);
+    EXPECT_EQ(static_cast<int64_t>(point_measures.interior_points), 0);
+    EXPECT_EQ(static_cast<int64_t>(point_measures.enclosed_cells()), 1);
+
+    auto const empty_measures = cpp_utils::measure_polygon(std::vector<Coords>{});
+    EXPECT_EQ(static_cast<int64_t>(empty_measures.enclosed_cells()), 0);
+  }
+
+}  // namespace
@@ -0,0 +1,181 @@
+#include <cpp_utils/coords2d.hpp>
+#include <cpp_utils/search.hpp>
+#include <cpp_utils/search_statistics_formatter.hpp>
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+namespace {
+
+  // Successors on an unbounded number line: x -> x + 1, x -> 2 * x
+  std::vector<int64_t> numberLineSuccessors(int64_t x) { return {x + 1, 2 * x}; }
+
+  std::vector<int64_t> numberLinePredecessors(int64_t x) {
+    std::vector<int64_t> result = {x - 1};
+    if (x % 2 == 0) {
+      result.push_back(x / 2);
+    }
+    return result;
+  }
+
+  TEST(BidirectionalSearchTest, StartIsGoal) {
+    auto const path = cpp_utils::bidirectionalSearch<int64_t>(5, 5, numberLineSuccessors,
+                                                               numberLinePredecessors);
+    ASSERT_TRUE(path.has_value());
+    EXPECT_EQ(*path, std::vector<int64_t>{5});
+  }
+
+  TEST(BidirectionalSearchTest, FindsShortestPath) {
+    auto const path = cpp_utils::bidirectionalSearch<int64_t>(1, 100, numberLineSuccessors,
+                                                               numberLinePredecessors);
+    ASSERT_TRUE(path.has_value());
+    // 1 -> 2 -> 3 -> 6 -> 12 -> 24 -> 25 -> 50 -> 100
+    EXPECT_EQ(path->size(), 9);
+    EXPECT_EQ(path->front(), 1);
+    EXPECT_EQ(path->back(), 100);
+    for (size_t i = 1; i < path->size(); ++i) {
+      auto const successors = numberLineSuccessors((*path)[i - 1]);
+      EXPECT_TRUE(std::ranges::find(successors, (*path)[i]) != successors.end());
+    }
+  }
+
+  TEST(BidirectionalSearchTest, UnreachableGoal) {
+    using Coords = cpp_utils::Coords2D<int64_t>;
+    // Moves inside a 3x3 box, the goal lies outside
+    auto neighbors = [](Coords coords) {
+      std::vector<Coords> result;
+      for (auto const& next : cpp_utils::get_direct_neighbour_coords(coords)) {
+        if (next.row() >= 0 && next.row() < 3 && next.col() >= 0 && next.col() < 3) {
+          result.push_back(next);
+        }
+      }
+      return result;
+    };
+    auto const path = cpp_utils::bidirectionalSearch<Coords>(Coords{0, 0}, Coords{5, 5}, neighbors,
+                                                             neighbors);
+    EXPECT_FALSE(path.has_value());
+  }
+
+  // Binary tree of depth 3 with nodes 1..15, node n has children 2n and 2n + 1
+  std::vector<int64_t> binaryTreeChildren(int64_t n) {
+    if (n >= 8) {
+      return {};
+    }
+    return {2 * n, 2 * n + 1};
+  }
+
+  bool isEven(int64_t n) { return n % 2 == 0; }
+
+  TEST(LazySearchTest, BreadthFirstYieldsGoalsInLevelOrder) {
+    std::vector<int64_t> goals;
+    for (auto const goal :
+         cpp_utils::lazyBreadthFirstSearch<int64_t>(1, binaryTreeChildren, isEven)) {
+      goals.push_back(goal);
+    }
+    EXPECT_EQ(goals, (std::vector<int64_t>{2, 4, 6, 8, 10, 12, 14}));
+  }
+
+  TEST(LazySearchTest, DepthFirstYieldsSameGoalsAsEagerSearch) {
+    std::vector<int64_t> goals;
+    for (auto const goal :
+         cpp_utils::lazyDepthFirstSearch<int64_t>(1, binaryTreeChildren, isEven)) {
+      goals.push_back(goal);
+    }
+    auto const eager =
+        cpp_utils::depthFirstSearch<int64_t, true, false>(1, binaryTreeChildren, isEven);
+    EXPECT_EQ(goals, eager);
+  }
+
+  TEST(LazySearchTest, StopsEarly) {
+    size_t num_expanded = 0;
+    auto successors = [&num_expanded](int64_t n) {
+      ++num_expanded;
+      return numberLineSuccessors(n);
+    };
+    // The search space is infinite, only the first three goals are requested
+    std::vector<int64_t> goals;
+    for (auto const goal : cpp_utils::lazyBreadthFirstSearch<int64_t>(1, successors, isEven) |
+                               std::views::take(3)) {
+      goals.push_back(goal);
+    }
+    EXPECT_EQ(goals, (std::vector<int64_t>{2, 2, 4}));
+    EXPECT_LT(num_expanded, 10);
+  }
+
+  TEST(LazySearchTest, YieldsDepth) {
+    std::vector<std::pair<int64_t, size_t>> goals;
+    for (auto const& goal :
+         cpp_utils::lazyBreadthFirstSearch<int64_t, true>(1, binaryTreeChildren, isEven)) {
+      goals.push_back(goal);
+    }
+    ASSERT_EQ(goals.size(), 7);
+    EXPECT_EQ(goals[0], std::make_pair(int64_t{2}, size_t{1}));
+    EXPECT_EQ(goals[1], std::make_pair(int64_t{4}, size_t{2}));
+    EXPECT_EQ(goals[6], std::make_pair(int64_t{14}, size_t{3}));
+  }
+
+  TEST(SearchStatisticsTest, CountsExpansionsAndGoals) {
+    cpp_utils::SearchStatistics stats;
+    auto const goals = cpp_utils::breadthFirstSearch<int64_t, true, false>(
+        1, binaryTreeChildren, isEven, stats);
+    EXPECT_EQ(goals.size(), 7);
+    EXPECT_EQ(stats.nodes_expanded, 15);
+    EXPECT_EQ(stats.goals_found, 7);
+    EXPECT_EQ(stats.duplicate_hits, 0);
+    EXPECT_EQ(stats.peak_frontier_size, 8);
+    size_t histogram_total = 0;
+    for (auto const count : stats.expansion_time_histogram) {
+      histogram_total += count;
+    }
+    EXPECT_EQ(histogram_total, stats.nodes_expanded);
+  }
+
+  TEST(SearchStatisticsTest, CountsDuplicateGoals) {
+    cpp_utils::SearchStatistics stats;
+    // Both children of 1 are 2, so every goal below is found twice
+    auto successors = [](int64_t n) {
+      return n < 4 ? std::vector<int64_t>{n + 1, 2 * n} : std::vector<int64_t>{};
+    };
+    auto const goals =
+        cpp_utils::depthFirstSearch<int64_t, true, true>(1, successors, isEven, stats);
+    EXPECT_EQ(goals.size(), 3);
+    EXPECT_GT(stats.duplicate_hits, 0);
+    EXPECT_EQ(stats.goals_found, goals.size() + stats.duplicate_hits);
+  }
+
+  TEST(SearchAllocatorTest, PmrResultAndFrontierUseMemoryResource) {
+    std::array<std::byte, 1 << 14> buffer;
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(),
+                                              std::pmr::null_memory_resource());
+    std::pmr::polymorphic_allocator<int64_t> allocator(&arena);
+    cpp_utils::pmr::SearchResult<int64_t, true> const goals =
+        cpp_utils::breadthFirstSearch<int64_t, true>(1, binaryTreeChildren, isEven,
+                                                     cpp_utils::NoSearchObserver{}, allocator);
+    EXPECT_EQ(goals.get_allocator().resource(), &arena);
+    EXPECT_EQ(goals.size(), 7);
+
+    auto const path = cpp_utils::bidirectionalSearch<int64_t>(
+        1, 100, numberLineSuccessors, numberLinePredecessors, cpp_utils::NoSearchObserver{},
+        allocator);
+    ASSERT_TRUE(path.has_value());
+    EXPECT_EQ(path->size(), 9);
+  }
+
+  TEST(SearchStatisticsTest, Format) {
+    cpp_utils::SearchStatistics stats;
+    cpp_utils::bidirectionalSearch<int64_t>(1, 100, numberLineSuccessors, numberLinePredecessors,
+                                            stats);
+    auto const formatted = fmt::format("{}", stats);
+    EXPECT_TRUE(formatted.starts_with("SearchStatistics(expanded="));
+    EXPECT_EQ(stats.goals_found, 1);
+  }
+
+}  // namespace